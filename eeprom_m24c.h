@@ -12,6 +12,12 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 
 // ========================================== I2C Interface ==========================================
@@ -71,6 +77,92 @@ public:
      */
     virtual void ReadMultipleBytes(uint8_t *output, uint16_t size) = 0;
 
+    /**
+     * @brief Optional time source. Lets the driver track the write cycle of the chip instead of ACK polling through it.
+     * @param now_us Set to a free-running microsecond counter that wraps at 2^32.
+     * @return false if the platform has no time source (default), the driver ACK polls then.
+     */
+    virtual bool GetTimeUs(uint32_t &now_us)
+    {
+        (void)now_us;
+        return false;
+    }
+
+    /**
+     * @brief Optional clock control for the adaptive bus speed, see EepromM24CBusSpeedPolicy.
+     * The new clock takes effect at the next Init(), the driver calls it before the next attempt.
+     * @param bus_hz The I2C clock.
+     * @return false if the platform cannot change the clock (default).
+     */
+    virtual bool SetBusSpeed(uint32_t bus_hz)
+    {
+        (void)bus_hz;
+        return false;
+    }
+
+    /**
+     * @brief Reads a word (32-bit) from the I2C bus, little-endian. I2C STOP condition included.
+     * Override when the platform has a cheaper fixed-size receive than the generic ReadMultipleBytes setup.
+     * @return The word value read from the I2C bus.
+     */
+    virtual uint32_t ReadWord()
+    {
+        uint8_t bytes[4];
+
+        ReadMultipleBytes(bytes, sizeof(bytes));
+
+        return bytes[0] | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16) |
+               (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    /**
+     * @brief Reads a doubleword (64-bit) from the I2C bus, little-endian. I2C STOP condition included.
+     * Override when the platform has a cheaper fixed-size receive than the generic ReadMultipleBytes setup.
+     * @return The doubleword value read from the I2C bus.
+     */
+    virtual uint64_t ReadDoubleWord()
+    {
+        uint8_t bytes[8];
+        uint64_t value = 0;
+
+        ReadMultipleBytes(bytes, sizeof(bytes));
+
+        for (uint8_t i = sizeof(bytes); i > 0; i--)
+        {
+            value = (value << 8) | bytes[i - 1];
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Reads exactly N bytes from the I2C bus through the cheapest fixed-size primitive:
+     * ReadByte, ReadHalfWord, ReadWord or ReadDoubleWord, ReadMultipleBytes for other sizes. I2C STOP condition included.
+     * @tparam N The number of bytes to read.
+     * @param output Pointer to the buffer where the bytes will be stored in bus order.
+     */
+    template <uint16_t N>
+    void ReadExact(uint8_t *output)
+    {
+        if constexpr (N == 1)
+        {
+            output[0] = ReadByte();
+        }
+        else if constexpr (N == 2 || N == 4 || N == 8)
+        {
+            uint64_t value = N == 2 ? ReadHalfWord() : (N == 4 ? ReadWord() : ReadDoubleWord());
+
+            for (uint8_t i = 0; i < N; i++)
+            {
+                output[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+        else
+        {
+            ReadMultipleBytes(output, N);
+        }
+    }
+
     /**
      * @brief Writes a single byte to the I2C bus
      * @param data The byte of data to write to the I2C bus.
@@ -83,6 +175,89 @@ public:
     virtual void Stop() = 0;
 };
 
+// ========================================= Byte Order ==========================================
+
+/**
+ * @brief Byte order of multi-byte values stored on the chip.
+ */
+enum class EepromEndianness
+{
+    Little,
+    Big,
+};
+
+/**
+ * @brief Byte order of the build target.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr EepromEndianness EEPROM_HOST_ENDIANNESS = EepromEndianness::Big;
+#else
+constexpr EepromEndianness EEPROM_HOST_ENDIANNESS = EepromEndianness::Little;
+#endif
+
+/**
+ * @brief Reverses the byte order of every element of an array in place.
+ * SSSE3 swaps 16 bytes per shuffle on the host, the MCU swaps whole words with the compiler byte-swap builtins (REV on Cortex-M).
+ * @tparam SIZE Element size in bytes: 2, 4 or 8.
+ * @param data Pointer to the elements.
+ * @param count Number of elements.
+ */
+template <uint8_t SIZE>
+void EepromByteSwap(uint8_t *data, uint16_t count)
+{
+    static_assert(SIZE == 2 || SIZE == 4 || SIZE == 8, "Elements of 2, 4 or 8 bytes");
+
+    uint16_t i = 0;
+
+#if defined(__SSSE3__)
+    alignas(16) uint8_t mask[16];
+
+    for (uint8_t j = 0; j < 16; j++)
+    {
+        mask[j] = static_cast<uint8_t>(j - j % SIZE + SIZE - 1 - j % SIZE);
+    }
+
+    const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+
+    for (; i + 16 / SIZE <= count; i += 16 / SIZE)
+    {
+        __m128i *block = reinterpret_cast<__m128i *>(data + i * SIZE);
+
+        _mm_storeu_si128(block, _mm_shuffle_epi8(_mm_loadu_si128(block), shuffle));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint8_t *element = data + i * SIZE;
+
+        if constexpr (SIZE == 2)
+        {
+            uint16_t word;
+
+            memcpy(&word, element, SIZE);
+            word = __builtin_bswap16(word);
+            memcpy(element, &word, SIZE);
+        }
+        else if constexpr (SIZE == 4)
+        {
+            uint32_t word;
+
+            memcpy(&word, element, SIZE);
+            word = __builtin_bswap32(word);
+            memcpy(element, &word, SIZE);
+        }
+        else
+        {
+            uint64_t word;
+
+            memcpy(&word, element, SIZE);
+            word = __builtin_bswap64(word);
+            memcpy(element, &word, SIZE);
+        }
+    }
+}
+
 // ========================================= Eeprom M24C ==========================================
 
 /**
@@ -110,6 +285,7 @@ struct EepromModelTraits<EepromM24CModel::M24C16>
 {
     static constexpr uint8_t PAGE_SIZE = 16;
     static constexpr uint16_t MEMORY_SIZE = 2048;
+    static constexpr uint16_t WRITE_CYCLE_TIME_US = 5000; // tW max from the datasheet
 };
 
 // Specializations for other models can be added as needed.
@@ -117,14 +293,30 @@ struct EepromModelTraits<EepromM24CModel::M24C16>
 // struct EepromModelTraits<EepromM24CModel::M24C32> {
 //     static constexpr uint8_t PAGE_SIZE = 32;
 //     static constexpr uint16_t MEMORY_SIZE = 4096;
+//     static constexpr uint16_t WRITE_CYCLE_TIME_US = 5000;
 // };
 
 // template<>
 // struct EepromModelTraits<EepromM24CModel::M24C64> {
 //     static constexpr uint8_t PAGE_SIZE = 32;
 //     static constexpr uint16_t MEMORY_SIZE = 8192;
+//     static constexpr uint16_t WRITE_CYCLE_TIME_US = 5000;
 // };
 
+/**
+ * @brief Adaptive bus speed: the driver counts failed attempts per window of transactions, steps the I2C
+ * clock down as soon as they cluster and back up after a run of clean windows. NACKs of the first
+ * transaction after a write are not counted, the chip may still be in its write cycle.
+ */
+struct EepromM24CBusSpeedPolicy
+{
+    const uint32_t *speeds_hz; /**< Clock steps, fastest first. Must outlive the driver */
+    uint8_t count;             /**< Number of steps, 0 disables the policy */
+    uint16_t window;           /**< Transactions per window */
+    uint16_t max_errors;       /**< Failed attempts within a window that step the clock down */
+    uint16_t clean_windows;    /**< Windows in a row without failed attempts that step the clock up */
+};
+
 /**
  * @brief STM EEPROM series M24C driver.
  *
@@ -138,20 +330,88 @@ class EepromM24C
 public:
     static constexpr uint8_t PAGE_SIZE = EepromModelTraits<model>::PAGE_SIZE;      /**< Page size in bytes for the specified model */
     static constexpr uint16_t MEMORY_SIZE = EepromModelTraits<model>::MEMORY_SIZE; /**< Total memory size in bytes for the specified model */
+    static constexpr uint16_t WRITE_CYCLE_TIME_US = EepromModelTraits<model>::WRITE_CYCLE_TIME_US; /**< Maximum write cycle time tW */
 
-    EepromM24C(I2C_M24C &i2c_instance) : i2c(i2c_instance) {} // Dependency injection of I2C instance
+    /**
+     * @param i2c_instance The I2C interface (dependency injection).
+     * @param max_attempts Attempts per bus transaction before the driver gives up, 0 retries until the transaction succeeds.
+     */
+    EepromM24C(I2C_M24C &i2c_instance, uint16_t max_attempts = 0) : i2c(i2c_instance), attempt_limit(max_attempts) {}
 
     void WriteByte(uint16_t address, uint8_t value);
     void WriteHalfWord(uint16_t address, uint16_t value);
     void WriteBlock(void *data, uint16_t address, uint16_t block_size);
+    void WritePage(void *data, uint16_t address, uint8_t data_size);
+    template <uint16_t ADDRESS, uint8_t SIZE>
+    void WriteBlock(const void *data);
 
     uint8_t ReadByte(uint16_t address);
     uint16_t ReadHalfWord(uint16_t address);
+    uint32_t ReadWord(uint16_t address);
+    uint64_t ReadDoubleWord(uint16_t address);
+    template <typename T>
+    T ReadScalar(uint16_t address);
     void ReadBlock(void *data, uint16_t address, uint16_t block_size);
+    template <uint16_t ADDRESS, uint16_t SIZE>
+    void ReadBlock(void *data);
+
+    template <typename T, EepromEndianness endianness = EepromEndianness::Little>
+    void ReadArray(T *data, uint16_t address, uint16_t count);
+    template <typename T, EepromEndianness endianness = EepromEndianness::Little>
+    void WriteArray(const T *data, uint16_t address, uint16_t count);
+
+    void Copy(uint16_t dst_address, uint16_t src_address, uint16_t length);
+    template <EepromM24CModel dst_model>
+    void CopyTo(EepromM24C<dst_model> &destination, uint16_t dst_address, uint16_t src_address, uint16_t length);
 
     void ChipErase();
     void ErasePage(uint16_t address);
 
+    /**
+     * @brief Sets the attempts per bus transaction, 0 retries until the transaction succeeds.
+     * A bounded count makes every call's duration bounded, see eeprom_m24c_timing.h.
+     */
+    void SetMaxAttempts(uint16_t max_attempts) { attempt_limit = max_attempts; }
+    uint16_t MaxAttempts() const { return attempt_limit; }
+
+    /**
+     * @brief true once a transaction ran out of attempts, its data was not transferred. Stays set until ClearTimeout().
+     */
+    bool IsTimedOut() const { return timed_out; }
+    void ClearTimeout() { timed_out = false; }
+
+    bool IsBusy();
+
+    /**
+     * @brief Waits until the first ACK poll for the last write is due. Every operation does this first, call it
+     * to move the wait to a better moment.
+     */
+    void WaitReady()
+    {
+        while (IsBusy())
+        {
+        }
+    }
+
+    /**
+     * @brief Forgets the tracked address counter of the chip. Call it when something else may have moved
+     * the counter: another bus master or driver instance on the same chip, or a power cycle of the chip.
+     */
+    void InvalidateAddressCounter() { address_counter = ADDRESS_UNKNOWN; }
+
+    /**
+     * @brief Learned write cycle time of this chip for writes of the given size, 0 until measured.
+     * Needs a time source, see I2C_M24C::GetTimeUs.
+     */
+    uint16_t WriteCycleEstimateUs(uint16_t size) const { return write_cycle_estimate_us[WriteSizeClass(size)]; }
+
+    void SetBusSpeedPolicy(const EepromM24CBusSpeedPolicy &policy);
+
+    /**
+     * @brief The clock step in use, 0 without a bus speed policy.
+     */
+    uint32_t BusSpeed() const { return speed_policy.count > 0 ? speed_policy.speeds_hz[speed_step] : 0; }
+
 private:
     static constexpr uint8_t DEVICE_ID = 0b10100000;               /**< I2C device ID for the EEPROM */
     static constexpr uint8_t CHIP_ENABLE_ADRESS_MASK = 0b00001110; /**< Mask to extract relevant address bits for chip enable */
@@ -161,40 +421,313 @@ private:
      * @param address The EEPROM address.
      * @return uint8_t The device select code.
      */
-    uint8_t HandleDeviceSelectCode(uint16_t address) const
+    static constexpr uint8_t HandleDeviceSelectCode(uint16_t address)
     {
         return DEVICE_ID | ((address >> CHIP_ENABLE_ADRESS_SHIFT) & CHIP_ENABLE_ADRESS_MASK);
     };
-    void WritePage(void *data, uint16_t address, uint8_t data_size);
 
-    I2C_M24C &i2c; // Reference to the I2C interface
+    template <uint16_t N>
+    void ReadExact(uint8_t *data, uint16_t address);
+
+    static constexpr uint16_t ADDRESS_UNKNOWN = 0xFFFF;    /**< The address counter of the chip is not known */
+    static constexpr uint8_t WRITE_SIZE_CLASSES = 3;       /**< Size classes of the write cycle estimate */
+    static constexpr uint8_t WRITE_CYCLE_MARGIN_SHIFT = 4; /**< The first ACK poll comes 1/16 of the estimate early */
+    static constexpr uint8_t WRITE_CYCLE_EWMA_SHIFT = 3;   /**< Weight 1/8 of a new write cycle sample */
+
+    /**
+     * @brief Address counter of the chip after reading size bytes from address: reads roll over at the end of the memory.
+     */
+    static constexpr uint16_t CounterAfter(uint16_t address, uint16_t size) { return static_cast<uint16_t>((address + size) % MEMORY_SIZE); }
+
+    /**
+     * @brief Starts a read at the address. The dummy write that loads the address counter is skipped when the
+     * counter already points there (current address read).
+     */
+    void StartRead(uint8_t device_code, uint16_t address, bool set_pos_bit = false)
+    {
+        if (address_counter == address)
+        {
+            i2c.StartPolling(device_code, i2c.RX, set_pos_bit);
+            return;
+        }
+
+        i2c.StartPolling(device_code, i2c.TX, set_pos_bit);
+        i2c.WriteByte(static_cast<uint8_t>(address));
+        i2c.StartPolling(device_code, i2c.RX);
+    }
+
+    template <typename Transfer>
+    bool Transaction(Transfer transfer, uint16_t counter_after = ADDRESS_UNKNOWN);
+    template <typename Transfer>
+    bool WriteTransaction(Transfer transfer, uint16_t size);
+    void UpdateWriteCycleEstimate(uint32_t ready_us, bool polled);
+    void CountBusError();
+    void CountBusTransaction();
+
+    /**
+     * @brief Size class of a write for the write cycle estimate: single byte, partial page, full page.
+     */
+    static constexpr uint8_t WriteSizeClass(uint16_t size) { return size <= 1 ? 0 : (size < PAGE_SIZE ? 1 : 2); }
+
+    I2C_M24C &i2c;                                             // Reference to the I2C interface
+    uint16_t attempt_limit;                                    // Attempts per transaction, 0 for unbounded
+    bool timed_out = false;                                    // A transaction ran out of attempts
+    uint16_t address_counter = ADDRESS_UNKNOWN;                // Address counter of the chip as left by the last read
+    bool write_cycle = false;                                  // A write cycle may still run, no poll before busy_until_us
+    uint32_t busy_until_us = 0;                                // First ACK poll, on the clock of I2C_M24C::GetTimeUs
+    bool write_cycle_unmeasured = false;                       // The next transaction measures the write cycle of the last write
+    uint8_t write_size_class = 0;                              // Size class of the last write
+    uint32_t write_started_us = 0;                             // End of the last write transaction
+    uint16_t write_cycle_estimate_us[WRITE_SIZE_CLASSES] = {}; // EWMA of the write cycle time per size class, 0 unknown
+    bool after_write = false;                                  // The chip may NACK the next transaction for its write cycle
+    EepromM24CBusSpeedPolicy speed_policy = {};                // Adaptive bus speed, disabled by default
+    uint8_t speed_step = 0;                                    // Index of the clock in use
+    uint16_t window_transactions = 0;                          // Transactions in the current window
+    uint16_t window_errors = 0;                                // Failed attempts in the current window
+    uint16_t clean_window_count = 0;                           // Windows in a row without failed attempts
 };
 
 // ========================================= Eeprom M24C Implementation ==========================================
 
 /**
- * @brief Writes a byte to the specified address.
- * @param address The EEPROM address to write to.
- * @param value The byte value to write.
+ * @brief Runs a bus transaction, repeating it while the I2C state reports an error (NACK while the chip
+ * is busy with a write cycle, bus fault). Gives up after the configured number of attempts.
+ * A failed attempt leaves the address counter of the chip unknown, so the retry addresses the read again.
+ * @param transfer Issues the whole transaction, from START to STOP.
+ * @param counter_after Address counter of the chip after a successful transfer. Writes leave it unknown.
+ * @return true if the transaction succeeded, false if it ran out of attempts.
  */
 template <EepromM24CModel model>
-void EepromM24C<model>::WriteByte(uint16_t address, uint8_t value)
+template <typename Transfer>
+bool EepromM24C<model>::Transaction(Transfer transfer, uint16_t counter_after)
 {
-    uint8_t device_code = HandleDeviceSelectCode(address);
+    uint16_t attempts = 0;
+    uint32_t attempt_us = 0;
+
+    WaitReady();
 
     do
     {
+        if (attempt_limit != 0 && attempts == attempt_limit)
+        {
+            address_counter = ADDRESS_UNKNOWN;
+            write_cycle_unmeasured = false;
+            timed_out = true;
+            after_write = false;
+            CountBusTransaction();
+            return false;
+        }
+
         if (i2c.IsStateError())
         {
+            address_counter = ADDRESS_UNKNOWN;
             i2c.Init();
         }
 
+        if (write_cycle_unmeasured)
+        {
+            i2c.GetTimeUs(attempt_us);
+        }
+
+        transfer();
+        attempts++;
+
+        if (i2c.IsStateError() && !after_write)
+        {
+            CountBusError();
+        }
+
+    } while (i2c.IsStateError());
+
+    if (write_cycle_unmeasured)
+    {
+        UpdateWriteCycleEstimate(attempt_us, attempts > 1);
+    }
+
+    address_counter = counter_after;
+    after_write = false;
+    CountBusTransaction();
+    return true;
+}
+
+/**
+ * @brief Enables the adaptive bus speed and starts at the fastest clock step.
+ * Without I2C_M24C::SetBusSpeed support the driver stays at the current clock.
+ * @param policy Clock steps and thresholds, a policy with count 0 disables the adaptation.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::SetBusSpeedPolicy(const EepromM24CBusSpeedPolicy &policy)
+{
+    speed_policy = policy;
+    speed_step = 0;
+    window_transactions = 0;
+    window_errors = 0;
+    clean_window_count = 0;
+
+    if (policy.count > 0 && i2c.SetBusSpeed(policy.speeds_hz[0]))
+    {
+        i2c.Init();
+    }
+}
+
+/**
+ * @brief Counts a failed attempt and steps the clock down once the window holds max_errors of them, so
+ * the retries of the running transaction already go out at the slower clock.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::CountBusError()
+{
+    if (speed_policy.count == 0)
+    {
+        return;
+    }
+
+    clean_window_count = 0;
+
+    if (++window_errors < speed_policy.max_errors || speed_step + 1 == speed_policy.count)
+    {
+        return;
+    }
+
+    if (i2c.SetBusSpeed(speed_policy.speeds_hz[speed_step + 1])) // Applied by the Init() before the retry
+    {
+        speed_step++;
+    }
+
+    window_transactions = 0;
+    window_errors = 0;
+}
+
+/**
+ * @brief Ends a transaction for the bus speed window and steps the clock up after enough clean windows.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::CountBusTransaction()
+{
+    if (speed_policy.count == 0 || ++window_transactions < speed_policy.window)
+    {
+        return;
+    }
+
+    clean_window_count = window_errors == 0 ? clean_window_count + 1 : 0;
+    window_transactions = 0;
+    window_errors = 0;
+
+    if (clean_window_count < speed_policy.clean_windows || speed_step == 0)
+    {
+        return;
+    }
+
+    clean_window_count = 0;
+
+    if (i2c.SetBusSpeed(speed_policy.speeds_hz[speed_step - 1]))
+    {
+        speed_step--;
+        i2c.Init();
+    }
+}
+
+/**
+ * @brief Runs a write transaction. With a time source the write cycle it starts is recorded and the call
+ * returns at once; the next operation waits until just before the predicted end of the cycle and ACK polls
+ * from there. Until a write of that size class has been measured the next operation polls at once.
+ * @param transfer Issues the whole transaction, from START to STOP.
+ * @param size Bytes written, selects the size class of the estimate.
+ * @return true if the transaction succeeded, false if it ran out of attempts.
+ */
+template <EepromM24CModel model>
+template <typename Transfer>
+bool EepromM24C<model>::WriteTransaction(Transfer transfer, uint16_t size)
+{
+    uint32_t now_us;
+
+    if (!Transaction(transfer))
+    {
+        return false;
+    }
+
+    if (i2c.GetTimeUs(now_us))
+    {
+        uint16_t estimate = write_cycle_estimate_us[WriteSizeClass(size)];
+
+        write_size_class = WriteSizeClass(size);
+        write_started_us = now_us;
+        busy_until_us = now_us + estimate - (estimate >> WRITE_CYCLE_MARGIN_SHIFT);
+        write_cycle = true;
+        write_cycle_unmeasured = true;
+    }
+
+    after_write = true;
+    return true;
+}
+
+/**
+ * @brief Feeds the first transaction after a write into the write cycle estimate of its size class.
+ * The chip was ready when the successful attempt started. If an earlier attempt was NACKed the sample is
+ * tight; otherwise it is only an upper bound and counts when it is below the estimate, which lets the
+ * estimate shrink until the first poll starts to hit the end of the cycle.
+ * @param ready_us Start of the successful attempt.
+ * @param polled Attempts before it failed.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::UpdateWriteCycleEstimate(uint32_t ready_us, bool polled)
+{
+    uint16_t &estimate = write_cycle_estimate_us[write_size_class];
+    uint32_t sample = ready_us - write_started_us;
+
+    write_cycle_unmeasured = false;
+    sample = sample < 1 ? 1 : (sample > WRITE_CYCLE_TIME_US ? WRITE_CYCLE_TIME_US : sample);
+
+    if (estimate == 0)
+    {
+        estimate = static_cast<uint16_t>(sample);
+    }
+    else if (polled || sample < estimate)
+    {
+        estimate = static_cast<uint16_t>(estimate + (static_cast<int32_t>(sample) - estimate) / (1 << WRITE_CYCLE_EWMA_SHIFT));
+    }
+}
+
+/**
+ * @brief Checks whether the write cycle of the last write is predicted to be still running.
+ * @return true until the first ACK poll for the last write is due. Always false without a time source,
+ * the next operation then ACK polls the chip at once.
+ */
+template <EepromM24CModel model>
+bool EepromM24C<model>::IsBusy()
+{
+    uint32_t now_us;
+
+    if (!write_cycle || !i2c.GetTimeUs(now_us))
+    {
+        return false;
+    }
+
+    if (static_cast<int32_t>(busy_until_us - now_us) > 0)
+    {
+        return true;
+    }
+
+    write_cycle = false;
+    return false;
+}
+
+/**
+ * @brief Writes a byte to the specified address.
+ * @param address The EEPROM address to write to.
+ * @param value The byte value to write.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::WriteByte(uint16_t address, uint8_t value)
+{
+    uint8_t device_code = HandleDeviceSelectCode(address);
+
+    WriteTransaction([&]() {
         i2c.StartPolling(device_code, i2c.TX);
         i2c.WriteByte(static_cast<uint8_t>(address));
         i2c.WriteByte(value);
         i2c.Stop();
-
-    } while (i2c.IsStateError());
+    }, 1);
 }
 
 /**
@@ -207,27 +740,21 @@ void EepromM24C<model>::WriteHalfWord(uint16_t address, uint16_t value)
 {
     uint8_t device_code = HandleDeviceSelectCode(address);
 
-    do
-    {
-        if (i2c.IsStateError())
-        {
-            i2c.Init();
-        }
-
+    WriteTransaction([&]() {
         i2c.StartPolling(device_code, i2c.TX);
         i2c.WriteByte(static_cast<uint8_t>(address));
         i2c.WriteByte(static_cast<uint8_t>(value));
         i2c.WriteByte(static_cast<uint8_t>(value >> 8));
         i2c.Stop();
-
-    } while (i2c.IsStateError());
+    }, 2);
 }
 
 /**
- * @brief Writes a page of data to the EEPROM.
+ * @brief Writes a page of data to the EEPROM in a single write cycle.
  * @param data Pointer to the data to write.
  * @param address The starting address of the page.
- * @param data_size The size of the data to write.
+ * @param data_size The size of the data to write. The range must not cross a page boundary,
+ * the chip wraps around within the page otherwise.
  */
 template <EepromM24CModel model>
 void EepromM24C<model>::WritePage(void *data_ptr, uint16_t address, uint8_t data_size)
@@ -235,13 +762,7 @@ void EepromM24C<model>::WritePage(void *data_ptr, uint16_t address, uint8_t data
     uint8_t *data = reinterpret_cast<uint8_t*>(data_ptr);
     uint8_t device_code = HandleDeviceSelectCode(address);
 
-    do
-    {
-        if (i2c.IsStateError())
-        {
-            i2c.Init();
-        }
-
+    WriteTransaction([&]() {
         i2c.StartPolling(device_code, i2c.TX);
         i2c.WriteByte(static_cast<uint8_t>(address));
 
@@ -251,8 +772,7 @@ void EepromM24C<model>::WritePage(void *data_ptr, uint16_t address, uint8_t data
         }
 
         i2c.Stop();
-
-    } while (i2c.IsStateError());
+    }, data_size);
 }
 
 /**
@@ -276,7 +796,40 @@ void EepromM24C<model>::WriteBlock(void *data_ptr, uint16_t address, uint16_t da
         remaining_full_pages--;
     }
 
-    WritePage(data, address, data_size % PAGE_SIZE);
+    if (data_size % PAGE_SIZE != 0)
+    {
+        WritePage(data, address, data_size % PAGE_SIZE);
+    }
+}
+
+/**
+ * @brief Writes a block at a compile-time address that stays within one page, as a single transaction.
+ * The device select code and the address byte are constants, no page loop and no runtime checks.
+ * @tparam ADDRESS The EEPROM address to write to.
+ * @tparam SIZE The size of the data, ADDRESS + SIZE must not cross a page boundary.
+ * @param data Pointer to the data to write.
+ */
+template <EepromM24CModel model>
+template <uint16_t ADDRESS, uint8_t SIZE>
+void EepromM24C<model>::WriteBlock(const void *data_ptr)
+{
+    static_assert(SIZE > 0 && ADDRESS % PAGE_SIZE + SIZE <= PAGE_SIZE, "Block must lie within one page");
+    static_assert(ADDRESS + SIZE <= MEMORY_SIZE, "Block exceeds the memory size");
+
+    constexpr uint8_t device_code = HandleDeviceSelectCode(ADDRESS);
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    WriteTransaction([&]() {
+        i2c.StartPolling(device_code, i2c.TX);
+        i2c.WriteByte(static_cast<uint8_t>(ADDRESS));
+
+        for (uint8_t i = 0; i < SIZE; i++)
+        {
+            i2c.WriteByte(data[i]);
+        }
+
+        i2c.Stop();
+    }, SIZE);
 }
 
 /**
@@ -288,21 +841,12 @@ template <EepromM24CModel model>
 uint8_t EepromM24C<model>::ReadByte(uint16_t address)
 {
     uint8_t device_code = HandleDeviceSelectCode(address);
-    uint8_t read_value;
+    uint8_t read_value = 0;
 
-    do
-    {
-        if (i2c.IsStateError())
-        {
-            i2c.Init();
-        }
-
-        i2c.StartPolling(device_code, i2c.TX);
-        i2c.WriteByte(static_cast<uint8_t>(address));
-        i2c.StartPolling(device_code, i2c.RX);
+    Transaction([&]() {
+        StartRead(device_code, address);
         read_value = i2c.ReadByte();
-
-    } while (i2c.IsStateError());
+    }, CounterAfter(address, 1));
 
     return read_value;
 }
@@ -318,23 +862,90 @@ uint16_t EepromM24C<model>::ReadHalfWord(uint16_t address)
     uint8_t device_code = HandleDeviceSelectCode(address);
     uint16_t read_value = 0;
 
-    do
-    {
-        if (i2c.IsStateError())
-        {
-            i2c.Init();
-        }
-
-        i2c.StartPolling(device_code, i2c.TX, 1);
-        i2c.WriteByte(static_cast<uint8_t>(address));
-        i2c.StartPolling(device_code, i2c.RX);
+    Transaction([&]() {
+        StartRead(device_code, address, 1);
         read_value = i2c.ReadHalfWord();
-
-    } while (i2c.IsStateError());
+    }, CounterAfter(address, 2));
 
     return read_value;
 }
 
+/**
+ * @brief Reads a block at a compile-time address, with the device select code and address byte folded into constants.
+ * @tparam ADDRESS The EEPROM address to read from.
+ * @tparam SIZE The size of the data.
+ * @param data Pointer to the buffer to store the read data.
+ */
+template <EepromM24CModel model>
+template <uint16_t ADDRESS, uint16_t SIZE>
+void EepromM24C<model>::ReadBlock(void *data_ptr)
+{
+    static_assert(SIZE > 0 && ADDRESS + SIZE <= MEMORY_SIZE, "Block exceeds the memory size");
+
+    constexpr uint8_t device_code = HandleDeviceSelectCode(ADDRESS);
+    uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+
+    Transaction([&]() {
+        StartRead(device_code, ADDRESS);
+        i2c.ReadMultipleBytes(data, SIZE);
+    }, CounterAfter(ADDRESS, SIZE));
+}
+
+/**
+ * @brief Reads a 32-bit word from the specified address, stored little-endian.
+ * @param address The EEPROM address to read from.
+ * @return The 32-bit value read from the address.
+ */
+template <EepromM24CModel model>
+uint32_t EepromM24C<model>::ReadWord(uint16_t address)
+{
+    return ReadScalar<uint32_t>(address);
+}
+
+/**
+ * @brief Reads a 64-bit doubleword from the specified address, stored little-endian.
+ * @param address The EEPROM address to read from.
+ * @return The 64-bit value read from the address.
+ */
+template <EepromM24CModel model>
+uint64_t EepromM24C<model>::ReadDoubleWord(uint16_t address)
+{
+    return ReadScalar<uint64_t>(address);
+}
+
+/**
+ * @brief Reads a scalar stored little-endian at the specified address, through the fixed-size I2C primitive of its size.
+ * @tparam T An integer, enum or floating-point type of 1, 2, 4 or 8 bytes.
+ * @param address The EEPROM address to read from.
+ * @return The value read from the address.
+ */
+template <EepromM24CModel model>
+template <typename T>
+T EepromM24C<model>::ReadScalar(uint16_t address)
+{
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "ReadScalar reads integers, enums and floating-point values");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "ReadScalar reads 1, 2, 4 or 8 bytes");
+
+    using Bits = typename std::conditional<sizeof(T) == 1, uint8_t,
+                 typename std::conditional<sizeof(T) == 2, uint16_t,
+                 typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+    uint8_t bytes[sizeof(T)];
+    Bits bits = 0;
+    T value;
+
+    ReadExact<sizeof(T)>(bytes, address);
+
+    for (uint8_t i = sizeof(T); i > 0; i--)
+    {
+        bits = static_cast<Bits>((static_cast<uint64_t>(bits) << 8) | bytes[i - 1]);
+    }
+
+    memcpy(&value, &bits, sizeof(T));
+
+    return value;
+}
+
 /**
  * @brief Reads a block of data from the EEPROM.
  * @param data Pointer to the buffer to store the read data.
@@ -347,37 +958,183 @@ void EepromM24C<model>::ReadBlock(void *data_ptr, uint16_t address, uint16_t dat
     uint8_t *data = reinterpret_cast<uint8_t*>(data_ptr);
     uint8_t device_code = HandleDeviceSelectCode(address);
 
-    do
+    Transaction([&]() {
+        StartRead(device_code, address);
+        i2c.ReadMultipleBytes(data, data_size);
+    }, CounterAfter(address, data_size));
+}
+
+/**
+ * @brief Reads exactly N bytes through I2C_M24C::ReadExact, so small fixed-size reads skip the generic ReadMultipleBytes setup.
+ * @param data Pointer to the buffer to store the read data.
+ * @param address The EEPROM address to read from.
+ */
+template <EepromM24CModel model>
+template <uint16_t N>
+void EepromM24C<model>::ReadExact(uint8_t *data, uint16_t address)
+{
+    uint8_t device_code = HandleDeviceSelectCode(address);
+
+    Transaction([&]() {
+        StartRead(device_code, address, N == 2);
+        i2c.template ReadExact<N>(data);
+    }, CounterAfter(address, N));
+}
+
+/**
+ * @brief Reads an array of integers or floating-point values with one sequential read, then converts the
+ * whole array from the on-chip byte order in bulk.
+ * @tparam T An integer or floating-point type of 1, 2, 4 or 8 bytes.
+ * @tparam endianness Byte order of the elements on the chip.
+ * @param data Pointer to the elements to read into.
+ * @param address The EEPROM address of the first element. Any alignment.
+ * @param count Number of elements.
+ */
+template <EepromM24CModel model>
+template <typename T, EepromEndianness endianness>
+void EepromM24C<model>::ReadArray(T *data, uint16_t address, uint16_t count)
+{
+    static_assert(std::is_arithmetic<T>::value, "ReadArray reads integer and floating-point arrays");
+
+    ReadBlock(data, address, static_cast<uint16_t>(count * sizeof(T)));
+
+    if constexpr (endianness != EEPROM_HOST_ENDIANNESS && sizeof(T) > 1)
     {
-        if (i2c.IsStateError())
+        EepromByteSwap<sizeof(T)>(reinterpret_cast<uint8_t *>(data), count);
+    }
+}
+
+/**
+ * @brief Writes an array of integers or floating-point values in the given on-chip byte order, one page
+ * write per touched page. Elements may straddle page boundaries, each page is converted in a page-sized bounce buffer.
+ * @tparam T An integer or floating-point type of 1, 2, 4 or 8 bytes.
+ * @tparam endianness Byte order of the elements on the chip.
+ * @param data Pointer to the elements to write.
+ * @param address The EEPROM address of the first element. Any alignment.
+ * @param count Number of elements.
+ */
+template <EepromM24CModel model>
+template <typename T, EepromEndianness endianness>
+void EepromM24C<model>::WriteArray(const T *data, uint16_t address, uint16_t count)
+{
+    static_assert(std::is_arithmetic<T>::value, "WriteArray writes integer and floating-point arrays");
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+    uint16_t size = static_cast<uint16_t>(count * sizeof(T));
+    uint16_t written = 0;
+    uint8_t page[PAGE_SIZE];
+
+    while (written < size)
+    {
+        uint8_t offset = static_cast<uint8_t>(address % PAGE_SIZE);
+        uint8_t chunk = static_cast<uint8_t>(size - written < PAGE_SIZE - offset ? size - written : PAGE_SIZE - offset);
+
+        for (uint8_t i = 0; i < chunk; i++)
         {
-            i2c.Init();
+            uint16_t position = written + i;
+
+            // Byte k of an element comes from byte SIZE-1-k of the source element when the order differs
+            page[i] = endianness == EEPROM_HOST_ENDIANNESS ? bytes[position]
+                                                           : bytes[position - position % sizeof(T) + sizeof(T) - 1 - position % sizeof(T)];
         }
 
-        i2c.StartPolling(device_code, i2c.TX);
-        i2c.WriteByte(static_cast<uint8_t>(address));
-        i2c.StartPolling(device_code, i2c.RX);
-        i2c.ReadMultipleBytes(data, data_size);
+        WritePage(page, address, chunk);
 
-    } while (i2c.IsStateError());
+        address += chunk;
+        written += chunk;
+    }
 }
 
 /**
- * @brief Erases a page by filling it with 0xFF.
- * @param address The start address of the page to erase.
+ * @brief Copies a range within the EEPROM through one page buffer, one read and one page write per touched
+ * destination page. Overlapping ranges are copied front to back when the destination lies below the source
+ * and back to front otherwise, so every source byte is read before it is overwritten.
+ * @param dst_address The EEPROM address to copy to.
+ * @param src_address The EEPROM address to copy from.
+ * @param length Number of bytes.
  */
 template <EepromM24CModel model>
-void EepromM24C<model>::ErasePage(uint16_t address)
+void EepromM24C<model>::Copy(uint16_t dst_address, uint16_t src_address, uint16_t length)
 {
-    uint8_t device_code = HandleDeviceSelectCode(address);
+    bool backwards = dst_address > src_address && dst_address < src_address + length;
+    uint16_t copied = 0;
+    uint8_t page[PAGE_SIZE];
 
-    do
+    if (dst_address == src_address)
     {
-        if (i2c.IsStateError())
+        return;
+    }
+
+    while (copied < length)
+    {
+        uint16_t remaining = length - copied;
+        uint16_t dst_end = dst_address + remaining; // Backwards: end of the part still to copy
+        uint16_t offset;
+        uint8_t chunk;
+
+        if (backwards)
         {
-            i2c.Init();
+            chunk = static_cast<uint8_t>(dst_end % PAGE_SIZE != 0 ? dst_end % PAGE_SIZE : PAGE_SIZE);
+            chunk = static_cast<uint8_t>(remaining < chunk ? remaining : chunk);
+            offset = remaining - chunk;
+        }
+        else
+        {
+            offset = copied;
+            chunk = static_cast<uint8_t>(PAGE_SIZE - (dst_address + offset) % PAGE_SIZE);
+            chunk = static_cast<uint8_t>(remaining < chunk ? remaining : chunk);
         }
 
+        ReadBlock(page, src_address + offset, chunk);
+        WritePage(page, dst_address + offset, chunk);
+
+        copied += chunk;
+    }
+}
+
+/**
+ * @brief Copies a range to another EEPROM through one page buffer of the destination page size.
+ * Write calls return while the chip programs, so the read of the next source page runs during the write
+ * cycle of the destination page before it; the destination only waits for tW what the read did not cover.
+ * Use Copy() within one device.
+ * @tparam dst_model The EEPROM model of the destination.
+ * @param destination The driver of the destination EEPROM.
+ * @param dst_address The address in the destination EEPROM to copy to.
+ * @param src_address The address in this EEPROM to copy from.
+ * @param length Number of bytes.
+ */
+template <EepromM24CModel model>
+template <EepromM24CModel dst_model>
+void EepromM24C<model>::CopyTo(EepromM24C<dst_model> &destination, uint16_t dst_address, uint16_t src_address, uint16_t length)
+{
+    constexpr uint8_t DST_PAGE_SIZE = EepromM24C<dst_model>::PAGE_SIZE;
+
+    uint16_t copied = 0;
+    uint8_t page[DST_PAGE_SIZE];
+
+    while (copied < length)
+    {
+        uint8_t chunk = static_cast<uint8_t>(DST_PAGE_SIZE - (dst_address + copied) % DST_PAGE_SIZE);
+
+        chunk = static_cast<uint8_t>(length - copied < chunk ? length - copied : chunk);
+
+        ReadBlock(page, src_address + copied, chunk);
+        destination.WritePage(page, dst_address + copied, chunk);
+
+        copied += chunk;
+    }
+}
+
+/**
+ * @brief Erases a page by filling it with 0xFF.
+ * @param address The start address of the page to erase.
+ */
+template <EepromM24CModel model>
+void EepromM24C<model>::ErasePage(uint16_t address)
+{
+    uint8_t device_code = HandleDeviceSelectCode(address);
+
+    WriteTransaction([&]() {
         i2c.StartPolling(device_code, i2c.TX);
         i2c.WriteByte(static_cast<uint8_t>(address));
 
@@ -387,8 +1144,7 @@ void EepromM24C<model>::ErasePage(uint16_t address)
         }
 
         i2c.Stop();
-
-    } while (i2c.IsStateError());
+    }, PAGE_SIZE);
 }
 
 /**
@@ -0,0 +1,281 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Persistent array container
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <iterator>
+#include <type_traits>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_cache.h"
+
+// ========================================= Eeprom M24C Persistent Array ==========================================
+
+/**
+ * @brief Fixed-size array of trivially copyable elements stored in the EEPROM.
+ *
+ * Element access goes through a small page cache, so neighbouring elements cost one page read instead of
+ * one addressed read each. Elements up to PAGE_SIZE bytes never straddle a page boundary: each page holds
+ * ELEMENTS_PER_PAGE elements and the remaining bytes of the page are left unused. Larger elements are
+ * stored back to back.
+ *
+ * Writes are buffered in the cache and reach the EEPROM on eviction or Flush, fill and assign write every
+ * page they cover completely once without reading it. Padding bytes and slots past N are written as 0xFF.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam T Element type.
+ * @tparam N Number of elements.
+ * @tparam CACHE_PAGES Number of pages cached in RAM.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES = 1>
+class EepromM24CPersistentArray
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                               /**< Page size in bytes for the specified model */
+    static constexpr uint8_t ELEMENTS_PER_PAGE = sizeof(T) <= PAGE_SIZE ? PAGE_SIZE / sizeof(T) : 0; /**< 0 if elements span pages */
+    static constexpr uint32_t FOOTPRINT = ELEMENTS_PER_PAGE != 0
+                                              ? static_cast<uint32_t>((N + ELEMENTS_PER_PAGE - 1) / ELEMENTS_PER_PAGE) * PAGE_SIZE
+                                              : static_cast<uint32_t>(N) * sizeof(T); /**< EEPROM bytes used by the array */
+
+    static_assert(std::is_trivially_copyable<T>::value, "Persistent array elements must be trivially copyable");
+    static_assert(FOOTPRINT <= EepromM24C<model>::MEMORY_SIZE, "Persistent array exceeds the memory size");
+
+    /**
+     * @brief Proxy returned by element access, reads and writes go through the cache.
+     */
+    class Reference
+    {
+    public:
+        Reference(EepromM24CPersistentArray &array_instance, uint16_t element_index) : array(array_instance), index(element_index) {}
+
+        operator T() const { return array.Get(index); }
+
+        Reference &operator=(const T &value)
+        {
+            array.Set(index, value);
+            return *this;
+        }
+
+        Reference &operator=(const Reference &other) { return *this = static_cast<T>(other); }
+
+    private:
+        EepromM24CPersistentArray &array;
+        uint16_t index;
+    };
+
+    /**
+     * @brief Random-access iterator over the array elements.
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+        Iterator() = default;
+        Iterator(EepromM24CPersistentArray *array_instance, uint16_t element_index) : array(array_instance), index(element_index) {}
+
+        Reference operator*() const { return Reference(*array, index); }
+        Reference operator[](difference_type offset) const { return Reference(*array, static_cast<uint16_t>(index + offset)); }
+
+        Iterator &operator++() { index++; return *this; }
+        Iterator &operator--() { index--; return *this; }
+        Iterator operator++(int) { Iterator previous = *this; index++; return previous; }
+        Iterator operator--(int) { Iterator previous = *this; index--; return previous; }
+        Iterator &operator+=(difference_type offset) { index = static_cast<uint16_t>(index + offset); return *this; }
+        Iterator &operator-=(difference_type offset) { index = static_cast<uint16_t>(index - offset); return *this; }
+        Iterator operator+(difference_type offset) const { return Iterator(array, static_cast<uint16_t>(index + offset)); }
+        Iterator operator-(difference_type offset) const { return Iterator(array, static_cast<uint16_t>(index - offset)); }
+        friend Iterator operator+(difference_type offset, const Iterator &it) { return it + offset; }
+        difference_type operator-(const Iterator &other) const { return static_cast<difference_type>(index) - other.index; }
+
+        bool operator==(const Iterator &other) const { return index == other.index; }
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+        bool operator<(const Iterator &other) const { return index < other.index; }
+        bool operator>(const Iterator &other) const { return index > other.index; }
+        bool operator<=(const Iterator &other) const { return index <= other.index; }
+        bool operator>=(const Iterator &other) const { return index >= other.index; }
+
+    private:
+        EepromM24CPersistentArray *array = nullptr;
+        uint16_t index = 0;
+    };
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param base_address Start address of the array. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CPersistentArray(EepromM24C<model> &eeprom_instance, uint16_t base_address)
+        : cache(eeprom_instance), base(base_address) {}
+
+    T Get(uint16_t index);
+    void Set(uint16_t index, const T &value);
+
+    void fill(const T &value);
+    template <typename InputIterator>
+    void assign(InputIterator first, InputIterator last);
+
+    /**
+     * @brief Writes all modified pages to the EEPROM.
+     */
+    void Flush() { cache.Flush(); }
+
+    Reference operator[](uint16_t index) { return Reference(*this, index); }
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, N); }
+    static constexpr uint16_t size() { return N; }
+
+    /**
+     * @brief EEPROM address of an element.
+     */
+    uint16_t Address(uint16_t index) const
+    {
+        if (ELEMENTS_PER_PAGE == 0)
+        {
+            return static_cast<uint16_t>(base + index * sizeof(T));
+        }
+
+        return static_cast<uint16_t>(base + (index / ELEMENTS_PER_PAGE) * PAGE_SIZE + (index % ELEMENTS_PER_PAGE) * sizeof(T));
+    }
+
+private:
+    template <typename Source>
+    void WriteSequence(Source next);
+
+    EepromM24CPageCache<model, CACHE_PAGES> cache;
+    uint16_t base;
+};
+
+// ========================================= Eeprom M24C Persistent Array Implementation ==========================================
+
+/**
+ * @brief Reads an element.
+ * @param index Element index.
+ * @return The element value.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES>
+T EepromM24CPersistentArray<model, T, N, CACHE_PAGES>::Get(uint16_t index)
+{
+    T value;
+
+    cache.Read(&value, Address(index), sizeof(T));
+
+    return value;
+}
+
+/**
+ * @brief Writes an element.
+ * @param index Element index.
+ * @param value The element value.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES>
+void EepromM24CPersistentArray<model, T, N, CACHE_PAGES>::Set(uint16_t index, const T &value)
+{
+    cache.Write(&value, Address(index), sizeof(T));
+}
+
+/**
+ * @brief Sets all elements to the value, page by page.
+ * @param value The element value.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES>
+void EepromM24CPersistentArray<model, T, N, CACHE_PAGES>::fill(const T &value)
+{
+    WriteSequence([&](T &element) {
+        element = value;
+        return true;
+    });
+}
+
+/**
+ * @brief Writes the elements of [first, last) starting at index 0, at most N of them; the elements after
+ * the sequence keep their values. Each page the sequence covers completely is built in RAM and written once.
+ * @param first Iterator to the first value.
+ * @param last Iterator past the last value.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES>
+template <typename InputIterator>
+void EepromM24CPersistentArray<model, T, N, CACHE_PAGES>::assign(InputIterator first, InputIterator last)
+{
+    WriteSequence([&](T &element) {
+        if (first == last)
+        {
+            return false;
+        }
+
+        element = *first;
+        ++first;
+        return true;
+    });
+}
+
+/**
+ * @brief Writes elements from index 0 on until the source ends or the array is full.
+ * @param next Callable as bool(T &element): stores the next value, returns false at the end of the source.
+ */
+template <EepromM24CModel model, typename T, uint16_t N, uint8_t CACHE_PAGES>
+template <typename Source>
+void EepromM24CPersistentArray<model, T, N, CACHE_PAGES>::WriteSequence(Source next)
+{
+    uint8_t page[PAGE_SIZE];
+    uint16_t index = 0;
+    T value;
+
+    while (index < N)
+    {
+        uint16_t page_address = Address(index);
+
+        if (ELEMENTS_PER_PAGE == 0)
+        {
+            if (!next(value))
+            {
+                return;
+            }
+
+            cache.Write(&value, page_address, sizeof(T));
+            index++;
+            continue;
+        }
+
+        uint8_t used = 0;
+        bool more = true;
+
+        memset(page, 0xFF, PAGE_SIZE);
+
+        while (used < ELEMENTS_PER_PAGE && index < N && (more = next(value)))
+        {
+            memcpy(page + used * sizeof(T), &value, sizeof(T));
+            used++;
+            index++;
+        }
+
+        // A page without elements left after the sequence is written whole, padding included, so it is never
+        // read. Otherwise only the new elements are merged into the cached page.
+        if (used == ELEMENTS_PER_PAGE || index == N)
+        {
+            cache.Write(page, page_address, PAGE_SIZE);
+        }
+        else if (used > 0)
+        {
+            cache.Write(page, page_address, static_cast<uint16_t>(used * sizeof(T)));
+        }
+
+        if (!more)
+        {
+            return;
+        }
+    }
+}
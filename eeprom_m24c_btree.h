@@ -0,0 +1,964 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Copy-on-write B+-tree
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Eeprom M24C B+-tree ==========================================
+
+/**
+ * @brief Ordered key-value store with point and range lookups, one node per NODE_PAGES pages.
+ *
+ * A lookup reads one node per tree level instead of scanning the table. Internal nodes are kept in a small
+ * RAM cache, so a warm point lookup usually costs a single leaf read.
+ *
+ * Updates are copy-on-write: the modified leaf and every node on the path to the root are written to free
+ * nodes, then the new root is committed by a superblock write. A power loss before the commit leaves the
+ * previous tree intact. The superblock holds two slots in the first page of the region, written alternately.
+ * Free nodes are not persisted, Mount rebuilds the free map by walking the tree. The nodes replaced by a
+ * commit stay reserved until the next commit has overwritten the older slot, so the older slot always
+ * describes an intact tree. If the tree of the newest slot is damaged, Mount falls back to it; it never
+ * formats a region that holds a valid superblock.
+ *
+ * Nodes are not merged on erase, a node is only removed once it becomes empty. Leaves are not linked, a
+ * range lookup walks down from the root once and then visits the subtrees in key order.
+ *
+ * Internal node layout: [kind][count] then count x [key][child]. The key of the first entry is not compared,
+ * the first child covers every key below the second key. Leaf layout: [kind][count] then count x [key][value].
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam Key Trivially copyable key type, ordered by operator<.
+ * @tparam Value Trivially copyable value type.
+ * @tparam NODES Number of nodes in the region.
+ * @tparam NODE_PAGES Pages per node.
+ * @tparam CACHE_NODES Number of internal nodes cached in RAM.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES = 1, uint8_t CACHE_NODES = 4>
+class EepromM24CBTree
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                                /**< Page size in bytes for the specified model */
+    static constexpr uint16_t NODE_SIZE = static_cast<uint16_t>(NODE_PAGES) * PAGE_SIZE;             /**< Node size in bytes */
+    static constexpr uint16_t LEAF_ENTRY_SIZE = sizeof(Key) + sizeof(Value);                         /**< Key + value */
+    static constexpr uint16_t INTERNAL_ENTRY_SIZE = sizeof(Key) + 1;                                 /**< Key + child node */
+    static constexpr uint8_t LEAF_CAPACITY = (NODE_SIZE - 2) / LEAF_ENTRY_SIZE;                      /**< Entries per leaf */
+    static constexpr uint8_t INTERNAL_CAPACITY = (NODE_SIZE - 2) / INTERNAL_ENTRY_SIZE;              /**< Children per internal node */
+    static constexpr uint32_t FOOTPRINT = PAGE_SIZE + static_cast<uint32_t>(NODES) * NODE_SIZE;      /**< Superblock page + nodes */
+    static constexpr uint8_t MAX_HEIGHT = 8;                                                         /**< Levels including the leaves */
+
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "Keys and values must be trivially copyable");
+    static_assert((NODE_SIZE - 2) / sizeof(Key) < 0xFF, "Node entry count is stored in one byte");
+    static_assert(LEAF_CAPACITY >= 2, "A leaf must hold at least two entries");
+    static_assert(INTERNAL_CAPACITY >= 3, "An internal node must hold at least three children");
+    static_assert(NODES >= 3 && NODES < 0xFF, "Node index is stored in one byte");
+    static_assert(EepromM24C<model>::PAGE_SIZE >= 2 * 8, "Superblock slots must share one page");
+    static_assert(CACHE_NODES > 0, "B+-tree needs at least one cached node");
+    static_assert(FOOTPRINT <= EepromM24C<model>::MEMORY_SIZE, "B+-tree exceeds the memory size");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param base_address Start address of the region. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CBTree(EepromM24C<model> &eeprom_instance, uint16_t base_address)
+        : eeprom(eeprom_instance), base(base_address) {}
+
+    bool Mount();
+    void Format();
+
+    bool Insert(const Key &key, const Value &value);
+    bool Erase(const Key &key);
+    bool Find(const Key &key, Value &value);
+
+    template <typename Callback>
+    uint16_t Range(const Key &low, const Key &high, Callback callback);
+
+    /**
+     * @brief Nodes used neither by the committed tree nor by the tree of the older superblock slot.
+     */
+    uint8_t FreeNodes() const { return free_nodes; }
+
+    /**
+     * @brief Number of levels, 1 for a tree consisting of a single leaf.
+     */
+    uint8_t Height() const { return height; }
+
+    /**
+     * @brief false after a Mount that found no intact tree, lookups and updates fail until Format().
+     */
+    bool IsMounted() const { return mounted; }
+
+private:
+    static constexpr uint8_t NONE = 0xFF;
+    static constexpr uint8_t SUPERBLOCK_MAGIC = 0xB7;
+    static constexpr uint8_t SLOT_SIZE = 8;
+    static constexpr uint8_t KIND_LEAF = 0x4C;
+    static constexpr uint8_t KIND_INTERNAL = 0x49;
+    static constexpr uint16_t MAX_ENTRY_SIZE = LEAF_ENTRY_SIZE > INTERNAL_ENTRY_SIZE ? LEAF_ENTRY_SIZE : INTERNAL_ENTRY_SIZE;
+
+    /**
+     * @brief Node image in RAM, with room for one entry over capacity before a split.
+     */
+    struct Node
+    {
+        uint8_t bytes[NODE_SIZE + MAX_ENTRY_SIZE];
+
+        bool IsLeaf() const { return bytes[0] == KIND_LEAF; }
+        uint8_t Count() const { return bytes[1]; }
+        uint16_t EntrySize() const { return IsLeaf() ? LEAF_ENTRY_SIZE : INTERNAL_ENTRY_SIZE; }
+        uint16_t UsedSize() const { return 2 + Count() * EntrySize(); }
+        uint8_t *Entry(uint8_t index) { return bytes + 2 + index * EntrySize(); }
+        const uint8_t *Entry(uint8_t index) const { return bytes + 2 + index * EntrySize(); }
+
+        Key KeyAt(uint8_t index) const
+        {
+            Key key;
+            memcpy(&key, Entry(index), sizeof(Key));
+            return key;
+        }
+
+        uint8_t ChildAt(uint8_t index) const { return Entry(index)[sizeof(Key)]; }
+        void SetKey(uint8_t index, const Key &key) { memcpy(Entry(index), &key, sizeof(Key)); }
+        void SetChild(uint8_t index, uint8_t child) { Entry(index)[sizeof(Key)] = child; }
+        void SetValue(uint8_t index, const Value &value) { memcpy(Entry(index) + sizeof(Key), &value, sizeof(Value)); }
+    };
+
+    struct CacheSlot
+    {
+        uint8_t node = NONE;
+        uint16_t last_use;
+        uint8_t bytes[NODE_SIZE];
+    };
+
+    static uint8_t LowerBound(const Node &node, const Key &key);
+    static uint8_t ChildIndex(const Node &node, const Key &key);
+    static void InsertEntry(Node &node, uint8_t index);
+    static void RemoveEntry(Node &node, uint8_t index);
+
+    uint16_t NodeAddress(uint8_t node) const { return base + PAGE_SIZE + node * NODE_SIZE; }
+
+    void ReadNode(uint8_t node_index, Node &node);
+    void WriteNode(uint8_t node_index, const Node &node);
+    void CacheNode(uint8_t node_index, const uint8_t *bytes);
+
+    uint8_t Allocate();
+    void Release(uint8_t node_index);
+    bool IsUsed(uint8_t node_index) const { return (used[node_index / 8] >> (node_index % 8)) & 1; }
+    void SetUsed(uint8_t node_index, bool is_used);
+
+    bool ReadSlot(uint8_t slot, uint16_t &slot_sequence, uint8_t &slot_root, uint8_t &slot_height);
+    void Commit(uint8_t new_root, uint8_t new_height);
+    bool MarkReachable(uint8_t node_index, uint8_t level);
+    void Retain(uint8_t node_index, uint8_t level, uint8_t tree_height);
+
+    bool InsertInto(uint8_t node_index, const Key &key, const Value &value, uint8_t &new_index, Key &split_key, uint8_t &split_index);
+    int8_t EraseFrom(uint8_t node_index, const Key &key, uint8_t &new_index);
+
+    template <typename Callback>
+    bool RangeFrom(uint8_t node_index, const Key &low, const Key &high, Callback &callback, uint16_t &visited);
+
+    EepromM24C<model> &eeprom;
+    uint16_t base;
+    uint16_t sequence = 0;
+    uint8_t next_slot = 0;
+    uint8_t root = 0;
+    uint8_t height = 1;
+    uint8_t free_nodes = 0;
+    uint8_t used[(NODES + 7) / 8] = {};
+    uint8_t released[2 * MAX_HEIGHT];        // Nodes of the committed tree replaced by the pending update
+    uint8_t released_count = 0;
+    uint8_t retired[2 * MAX_HEIGHT];         // Nodes replaced by the last commit, the older slot still refers to them
+    uint8_t retired_count = 0;
+    uint16_t use_counter = 0;
+    CacheSlot cache[CACHE_NODES] = {};
+    bool mounted = false;
+};
+
+// ========================================= Eeprom M24C B+-tree Implementation ==========================================
+
+/**
+ * @brief Loads the newest superblock whose tree is intact and rebuilds the free node map. The older slot
+ * still describes the previous tree, it is used when the tree of the newest slot fails the check.
+ * @return true if a tree was mounted, an empty one if the region held no valid superblock and was
+ * formatted. false if no superblock leads to an intact tree; nothing is written then and IsMounted()
+ * stays false until the caller decides to Format().
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Mount()
+{
+    uint16_t sequence_a = 0, sequence_b = 0;
+    uint8_t root_a = 0, root_b = 0, height_a = 0, height_b = 0;
+    bool valid_a = ReadSlot(0, sequence_a, root_a, height_a);
+    bool valid_b = ReadSlot(1, sequence_b, root_b, height_b);
+
+    for (CacheSlot &slot : cache)
+    {
+        slot.node = NONE;
+    }
+
+    released_count = 0;
+    retired_count = 0;
+    mounted = false;
+
+    if (!valid_a && !valid_b)
+    {
+        Format();
+        return true;
+    }
+
+    bool newer_a = valid_a && (!valid_b || static_cast<int16_t>(sequence_a - sequence_b) > 0);
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++)
+    {
+        bool use_a = (attempt == 0) == newer_a;
+
+        if (!(use_a ? valid_a : valid_b))
+        {
+            continue;
+        }
+
+        // The next commit overwrites the other slot, a damaged newest slot included
+        sequence = use_a ? sequence_a : sequence_b;
+        root = use_a ? root_a : root_b;
+        height = use_a ? height_a : height_b;
+        next_slot = use_a ? 1 : 0;
+
+        memset(used, 0, sizeof(used));
+        free_nodes = NODES;
+
+        if (MarkReachable(root, 1))
+        {
+            // The older slot is overwritten by the next commit, until then its nodes must not be reused
+            if (attempt == 0 && (use_a ? valid_b : valid_a))
+            {
+                Retain(use_a ? root_b : root_a, 1, use_a ? height_b : height_a);
+            }
+
+            mounted = true;
+            return true;
+        }
+    }
+
+    free_nodes = 0;
+
+    return false;
+}
+
+/**
+ * @brief Creates an empty tree. One node write and two superblock writes, both slots describe the empty
+ * tree so Mount never falls back to a tree from before the format.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Format()
+{
+    Node leaf;
+
+    memset(used, 0, sizeof(used));
+    free_nodes = NODES;
+    released_count = 0;
+    retired_count = 0;
+
+    for (CacheSlot &slot : cache)
+    {
+        slot.node = NONE;
+    }
+
+    leaf.bytes[0] = KIND_LEAF;
+    leaf.bytes[1] = 0;
+
+    uint8_t leaf_index = Allocate();
+
+    WriteNode(leaf_index, leaf);
+    Commit(leaf_index, 1);
+    Commit(leaf_index, 1);
+    mounted = true;
+}
+
+/**
+ * @brief Inserts a key or replaces its value. Rewrites the path from the leaf to the root and the superblock,
+ * nothing is written if the key already holds the value.
+ * @return false if there are not enough free nodes for the path copy or no tree is mounted, true otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Insert(const Key &key, const Value &value)
+{
+    // Worst case every level splits and the root grows a level
+    if (!mounted || height >= MAX_HEIGHT || free_nodes < 2 * height + 1)
+    {
+        return false;
+    }
+
+    uint8_t new_root = NONE;
+    uint8_t split_index = NONE;
+    Key split_key{};
+
+    if (!InsertInto(root, key, value, new_root, split_key, split_index))
+    {
+        return true;
+    }
+
+    uint8_t new_height = height;
+
+    if (split_index != NONE)
+    {
+        Node top;
+
+        top.bytes[0] = KIND_INTERNAL;
+        top.bytes[1] = 2;
+        top.SetKey(0, Key{});
+        top.SetChild(0, new_root);
+        top.SetKey(1, split_key);
+        top.SetChild(1, split_index);
+
+        new_root = Allocate();
+        WriteNode(new_root, top);
+        new_height++;
+    }
+
+    Commit(new_root, new_height);
+
+    return true;
+}
+
+/**
+ * @brief Removes a key. Rewrites the path from the leaf to the root and the superblock.
+ * @return false if the key was not found, there are not enough free nodes for the path copy or no tree is mounted, true otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Erase(const Key &key)
+{
+    if (!mounted || free_nodes < height + 1)
+    {
+        return false;
+    }
+
+    uint8_t new_root = NONE;
+    int8_t result = EraseFrom(root, key, new_root);
+
+    if (result < 0)
+    {
+        return false;
+    }
+
+    uint8_t new_height = height;
+
+    if (new_root == NONE)
+    {
+        Node leaf;
+
+        leaf.bytes[0] = KIND_LEAF;
+        leaf.bytes[1] = 0;
+        new_root = Allocate();
+        WriteNode(new_root, leaf);
+        new_height = 1;
+    }
+
+    // A root left with a single child is dropped, the tree gets one level shorter
+    while (new_height > 1)
+    {
+        Node node;
+
+        ReadNode(new_root, node);
+
+        if (node.Count() != 1)
+        {
+            break;
+        }
+
+        Release(new_root);
+        new_root = node.ChildAt(0);
+        new_height--;
+    }
+
+    Commit(new_root, new_height);
+
+    return true;
+}
+
+/**
+ * @brief Looks up a key.
+ * @param key The key.
+ * @param value Receives the value if the key was found.
+ * @return true if the key was found, false otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Find(const Key &key, Value &value)
+{
+    Node node;
+    uint8_t node_index = root;
+
+    if (!mounted)
+    {
+        return false;
+    }
+
+    ReadNode(node_index, node);
+
+    while (!node.IsLeaf())
+    {
+        node_index = node.ChildAt(ChildIndex(node, key));
+        ReadNode(node_index, node);
+    }
+
+    uint8_t index = LowerBound(node, key);
+
+    if (index == node.Count() || key < node.KeyAt(index))
+    {
+        return false;
+    }
+
+    memcpy(&value, node.Entry(index) + sizeof(Key), sizeof(Value));
+
+    return true;
+}
+
+/**
+ * @brief Visits the keys in [low, high] in ascending order.
+ * @param low The lowest key to visit.
+ * @param high The highest key to visit.
+ * @param callback Called as callback(key, value) for every key in the range, returns false to stop the lookup.
+ * @return Number of visited keys.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+template <typename Callback>
+uint16_t EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Range(const Key &low, const Key &high, Callback callback)
+{
+    uint16_t visited = 0;
+
+    if (mounted)
+    {
+        RangeFrom(root, low, high, callback, visited);
+    }
+
+    return visited;
+}
+
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+template <typename Callback>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::RangeFrom(uint8_t node_index, const Key &low, const Key &high, Callback &callback, uint16_t &visited)
+{
+    Node node;
+
+    ReadNode(node_index, node);
+
+    if (node.IsLeaf())
+    {
+        for (uint8_t i = LowerBound(node, low); i < node.Count(); i++)
+        {
+            Key key = node.KeyAt(i);
+            Value value;
+
+            if (high < key)
+            {
+                return false;
+            }
+
+            memcpy(&value, node.Entry(i) + sizeof(Key), sizeof(Value));
+            visited++;
+
+            if (!callback(key, value))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    for (uint8_t i = ChildIndex(node, low); i < node.Count(); i++)
+    {
+        if (high < node.KeyAt(i) && i != 0)
+        {
+            return false;
+        }
+
+        if (!RangeFrom(node.ChildAt(i), low, high, callback, visited))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Inserts into the subtree and writes the modified copy of the node to a free node.
+ * @param new_index Receives the copy of the node.
+ * @param split_key Receives the lowest key of the new right sibling if the node was split.
+ * @param split_index Receives the new right sibling, NONE if the node was not split.
+ * @return false if nothing changed, true otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::InsertInto(uint8_t node_index, const Key &key, const Value &value,
+                                                                                    uint8_t &new_index, Key &split_key, uint8_t &split_index)
+{
+    Node node;
+    uint8_t capacity;
+
+    ReadNode(node_index, node);
+
+    if (node.IsLeaf())
+    {
+        uint8_t index = LowerBound(node, key);
+
+        if (index < node.Count() && !(key < node.KeyAt(index)))
+        {
+            if (memcmp(node.Entry(index) + sizeof(Key), &value, sizeof(Value)) == 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            InsertEntry(node, index);
+            node.SetKey(index, key);
+        }
+
+        node.SetValue(index, value);
+        capacity = LEAF_CAPACITY;
+    }
+    else
+    {
+        uint8_t index = ChildIndex(node, key);
+        uint8_t child = NONE;
+        uint8_t child_split = NONE;
+        Key child_key{};
+
+        if (!InsertInto(node.ChildAt(index), key, value, child, child_key, child_split))
+        {
+            return false;
+        }
+
+        node.SetChild(index, child);
+
+        if (child_split != NONE)
+        {
+            InsertEntry(node, index + 1);
+            node.SetKey(index + 1, child_key);
+            node.SetChild(index + 1, child_split);
+        }
+
+        capacity = INTERNAL_CAPACITY;
+    }
+
+    Release(node_index);
+
+    if (node.Count() > capacity)
+    {
+        Node right;
+        uint8_t left_count = node.Count() / 2;
+        uint8_t right_count = node.Count() - left_count;
+
+        right.bytes[0] = node.bytes[0];
+        right.bytes[1] = right_count;
+        memcpy(right.Entry(0), node.Entry(left_count), right_count * node.EntrySize());
+        node.bytes[1] = left_count;
+
+        split_key = right.KeyAt(0);
+        split_index = Allocate();
+        WriteNode(split_index, right);
+    }
+
+    new_index = Allocate();
+    WriteNode(new_index, node);
+
+    return true;
+}
+
+/**
+ * @brief Erases from the subtree and writes the modified copy of the node to a free node.
+ * @param new_index Receives the copy of the node, NONE if the node became empty.
+ * @return -1 if the key was not found, 0 otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+int8_t EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::EraseFrom(uint8_t node_index, const Key &key, uint8_t &new_index)
+{
+    Node node;
+
+    ReadNode(node_index, node);
+
+    if (node.IsLeaf())
+    {
+        uint8_t index = LowerBound(node, key);
+
+        if (index == node.Count() || key < node.KeyAt(index))
+        {
+            return -1;
+        }
+
+        RemoveEntry(node, index);
+    }
+    else
+    {
+        uint8_t index = ChildIndex(node, key);
+        uint8_t child = NONE;
+
+        if (EraseFrom(node.ChildAt(index), key, child) < 0)
+        {
+            return -1;
+        }
+
+        if (child != NONE)
+        {
+            node.SetChild(index, child);
+        }
+        else
+        {
+            RemoveEntry(node, index);
+        }
+    }
+
+    Release(node_index);
+
+    if (node.Count() == 0)
+    {
+        new_index = NONE;
+    }
+    else
+    {
+        new_index = Allocate();
+        WriteNode(new_index, node);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Index of the first leaf entry not less than the key.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+uint8_t EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::LowerBound(const Node &node, const Key &key)
+{
+    uint8_t low = 0;
+    uint8_t high = node.Count();
+
+    while (low < high)
+    {
+        uint8_t middle = (low + high) / 2;
+
+        if (node.KeyAt(middle) < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Index of the child covering the key: the last entry whose key is not greater, the first entry otherwise.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+uint8_t EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::ChildIndex(const Node &node, const Key &key)
+{
+    uint8_t low = 1;
+    uint8_t high = node.Count();
+
+    while (low < high)
+    {
+        uint8_t middle = (low + high) / 2;
+
+        if (key < node.KeyAt(middle))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return low - 1;
+}
+
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::InsertEntry(Node &node, uint8_t index)
+{
+    memmove(node.Entry(index + 1), node.Entry(index), (node.Count() - index) * node.EntrySize());
+    node.bytes[1]++;
+}
+
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::RemoveEntry(Node &node, uint8_t index)
+{
+    memmove(node.Entry(index), node.Entry(index + 1), (node.Count() - index - 1) * node.EntrySize());
+    node.bytes[1]--;
+}
+
+/**
+ * @brief Reads a node, internal nodes are served from the cache.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::ReadNode(uint8_t node_index, Node &node)
+{
+    use_counter++;
+
+    for (CacheSlot &slot : cache)
+    {
+        if (slot.node == node_index)
+        {
+            slot.last_use = use_counter;
+            memcpy(node.bytes, slot.bytes, NODE_SIZE);
+            return;
+        }
+    }
+
+    eeprom.ReadBlock(node.bytes, NodeAddress(node_index), NODE_SIZE);
+
+    if (!node.IsLeaf())
+    {
+        CacheNode(node_index, node.bytes);
+    }
+}
+
+/**
+ * @brief Writes the used part of a node, one WritePage per page.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::WriteNode(uint8_t node_index, const Node &node)
+{
+    uint16_t used_size = node.UsedSize();
+    uint16_t address = NodeAddress(node_index);
+
+    for (uint16_t offset = 0; offset < used_size; offset += PAGE_SIZE)
+    {
+        uint8_t chunk = static_cast<uint8_t>(used_size - offset < PAGE_SIZE ? used_size - offset : PAGE_SIZE);
+
+        eeprom.WritePage(const_cast<uint8_t *>(node.bytes + offset), address + offset, chunk);
+    }
+
+    if (!node.IsLeaf())
+    {
+        use_counter++;
+        CacheNode(node_index, node.bytes);
+    }
+}
+
+/**
+ * @brief Stores an internal node in the least recently used cache slot.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::CacheNode(uint8_t node_index, const uint8_t *bytes)
+{
+    CacheSlot *victim = &cache[0];
+
+    for (CacheSlot &slot : cache)
+    {
+        if (slot.node == NONE)
+        {
+            victim = &slot;
+            break;
+        }
+
+        if (static_cast<uint16_t>(use_counter - slot.last_use) > static_cast<uint16_t>(use_counter - victim->last_use))
+        {
+            victim = &slot;
+        }
+    }
+
+    victim->node = node_index;
+    victim->last_use = use_counter;
+    memcpy(victim->bytes, bytes, NODE_SIZE);
+}
+
+/**
+ * @brief Takes a node that is free in the committed tree.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+uint8_t EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Allocate()
+{
+    uint8_t node_index = 0;
+
+    while (IsUsed(node_index))
+    {
+        node_index++;
+    }
+
+    SetUsed(node_index, true);
+
+    // Nodes are immutable while allocated, a reused index must not be served from the cache
+    for (CacheSlot &slot : cache)
+    {
+        if (slot.node == node_index)
+        {
+            slot.node = NONE;
+        }
+    }
+
+    return node_index;
+}
+
+/**
+ * @brief Schedules a node of the committed tree to be freed once the update is committed.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Release(uint8_t node_index)
+{
+    released[released_count++] = node_index;
+}
+
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::SetUsed(uint8_t node_index, bool is_used)
+{
+    if (is_used)
+    {
+        used[node_index / 8] |= static_cast<uint8_t>(1 << (node_index % 8));
+        free_nodes--;
+    }
+    else
+    {
+        used[node_index / 8] &= static_cast<uint8_t>(~(1 << (node_index % 8)));
+        free_nodes++;
+    }
+}
+
+/**
+ * @brief Reads a superblock slot: [magic][sequence LE16][root][height][crc LE16].
+ * @return true if the slot is valid.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::ReadSlot(uint8_t slot, uint16_t &slot_sequence, uint8_t &slot_root, uint8_t &slot_height)
+{
+    uint8_t record[7];
+
+    eeprom.ReadBlock(record, base + slot * SLOT_SIZE, sizeof(record));
+
+    if (record[0] != SUPERBLOCK_MAGIC || EepromCrc16(record, 5) != static_cast<uint16_t>(record[5] | (record[6] << 8)))
+    {
+        return false;
+    }
+
+    slot_sequence = static_cast<uint16_t>(record[1] | (record[2] << 8));
+    slot_root = record[3];
+    slot_height = record[4];
+
+    return slot_root < NODES && slot_height >= 1 && slot_height <= MAX_HEIGHT;
+}
+
+/**
+ * @brief Makes the new root current with one superblock write. The nodes replaced by the previous commit
+ * are freed, the slot that referred to them has just been overwritten; the nodes replaced now stay
+ * reserved for the older slot.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Commit(uint8_t new_root, uint8_t new_height)
+{
+    uint8_t record[7];
+
+    sequence++;
+    record[0] = SUPERBLOCK_MAGIC;
+    record[1] = static_cast<uint8_t>(sequence);
+    record[2] = static_cast<uint8_t>(sequence >> 8);
+    record[3] = new_root;
+    record[4] = new_height;
+
+    uint16_t crc = EepromCrc16(record, 5);
+
+    record[5] = static_cast<uint8_t>(crc);
+    record[6] = static_cast<uint8_t>(crc >> 8);
+
+    eeprom.WritePage(record, base + next_slot * SLOT_SIZE, sizeof(record));
+    next_slot ^= 1;
+
+    root = new_root;
+    height = new_height;
+
+    for (uint8_t i = 0; i < retired_count; i++)
+    {
+        SetUsed(retired[i], false);
+    }
+
+    memcpy(retired, released, released_count);
+    retired_count = released_count;
+    released_count = 0;
+}
+
+/**
+ * @brief Marks the subtree as used, checking that every node is referenced once and sits on the right level.
+ * @return false if the tree is inconsistent.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+bool EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::MarkReachable(uint8_t node_index, uint8_t level)
+{
+    Node node;
+
+    if (node_index >= NODES || IsUsed(node_index))
+    {
+        return false;
+    }
+
+    ReadNode(node_index, node);
+    SetUsed(node_index, true);
+
+    if (node.IsLeaf())
+    {
+        return level == height && node.Count() <= LEAF_CAPACITY;
+    }
+
+    if (node.bytes[0] != KIND_INTERNAL || level == height || node.Count() == 0 || node.Count() > INTERNAL_CAPACITY)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < node.Count(); i++)
+    {
+        if (!MarkReachable(node.ChildAt(i), level + 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reserves the nodes of the older slot's tree that the mounted tree does not share. Copy-on-write
+ * shares whole subtrees, so only nodes not marked yet are followed. The older tree is not validated, at
+ * most the nodes of one commit are reserved.
+ */
+template <EepromM24CModel model, typename Key, typename Value, uint8_t NODES, uint8_t NODE_PAGES, uint8_t CACHE_NODES>
+void EepromM24CBTree<model, Key, Value, NODES, NODE_PAGES, CACHE_NODES>::Retain(uint8_t node_index, uint8_t level, uint8_t tree_height)
+{
+    Node node;
+
+    if (node_index >= NODES || IsUsed(node_index) || retired_count == sizeof(retired))
+    {
+        return;
+    }
+
+    SetUsed(node_index, true);
+    retired[retired_count++] = node_index;
+
+    if (level >= tree_height)
+    {
+        return;
+    }
+
+    ReadNode(node_index, node);
+
+    if (node.bytes[0] != KIND_INTERNAL || node.Count() > INTERNAL_CAPACITY)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < node.Count(); i++)
+    {
+        Retain(node.ChildAt(i), level + 1, tree_height);
+    }
+}
@@ -0,0 +1,394 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Page cache
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_cache_policy.h"
+
+// ========================================= Eeprom M24C Page Cache ==========================================
+
+/**
+ * @brief Write-back page cache with a pluggable replacement policy.
+ *
+ * Reads are served from cached pages, a miss loads the whole page with one ReadBlock. Writes modify the
+ * cached page and mark it dirty, the page is written back with a single WritePage on eviction or Flush.
+ * Writes covering a whole page do not read it first.
+ *
+ * Pages are found through a per-device-page slot map, lookups and policy updates are O(1). The policy is
+ * EepromM24CLruPolicy, EepromM24CClockPolicy or EepromM24CArcPolicy; ARC keeps a scan from evicting pages
+ * that are accessed repeatedly, at the cost of about 3 bytes of RAM per device page.
+ *
+ * LeasePage hands out the cached page itself instead of copying it. A leased page is pinned: it stays in
+ * its slot until the lease is released, so parsers can work on the cached bytes in place. Releasing a
+ * writable lease marks the page dirty. When every slot is pinned, Read and Write bypass the cache.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam SLOTS Number of cached pages.
+ * @tparam Policy Replacement policy template.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy = EepromM24CLruPolicy>
+class EepromM24CPageCache
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                     /**< Page size in bytes for the specified model */
+    static constexpr uint16_t PAGES = EepromM24C<model>::MEMORY_SIZE / PAGE_SIZE;          /**< Pages of the device */
+
+    static_assert(SLOTS > 0 && SLOTS < 0xFF, "Page cache needs 1 to 254 slots");
+
+private:
+    struct Slot;
+
+public:
+    /**
+     * @brief Pins a cached page for direct access, released on destruction. Move-only.
+     * @tparam WRITABLE true for a writable lease, the page is marked dirty on release.
+     */
+    template <bool WRITABLE>
+    class PageLease
+    {
+    public:
+        using Byte = typename std::conditional<WRITABLE, uint8_t, const uint8_t>::type;
+
+        PageLease() = default;
+        PageLease(const PageLease &) = delete;
+        PageLease &operator=(const PageLease &) = delete;
+        PageLease(PageLease &&other) : slot(other.slot) { other.slot = nullptr; }
+
+        PageLease &operator=(PageLease &&other)
+        {
+            if (this != &other)
+            {
+                Release();
+                slot = other.slot;
+                other.slot = nullptr;
+            }
+
+            return *this;
+        }
+
+        ~PageLease() { Release(); }
+
+        /**
+         * @brief false if no slot was available for the page.
+         */
+        explicit operator bool() const { return slot != nullptr; }
+
+        Byte *data() const { return slot->data; }
+        Byte *begin() const { return slot->data; }
+        Byte *end() const { return slot->data + PAGE_SIZE; }
+        Byte &operator[](uint8_t offset) const { return slot->data[offset]; }
+        static constexpr uint8_t size() { return PAGE_SIZE; }
+
+        /**
+         * @brief Start address of the leased page.
+         */
+        uint16_t Address() const { return slot->page_address; }
+
+        /**
+         * @brief Ends the lease before destruction.
+         */
+        void Release()
+        {
+            if (slot != nullptr)
+            {
+                slot->dirty = slot->dirty || WRITABLE;
+                slot->pins--;
+                slot = nullptr;
+            }
+        }
+
+    private:
+        friend class EepromM24CPageCache;
+
+        explicit PageLease(Slot *leased_slot) : slot(leased_slot)
+        {
+            if (slot != nullptr)
+            {
+                slot->pins++;
+            }
+        }
+
+        Slot *slot = nullptr;
+    };
+
+    using ReadLease = PageLease<false>;
+    using WriteLease = PageLease<true>;
+
+    EepromM24CPageCache(EepromM24C<model> &eeprom_instance) : eeprom(eeprom_instance)
+    {
+        memset(slot_of, NONE, sizeof(slot_of));
+
+        for (uint8_t i = 0; i < SLOTS; i++)
+        {
+            free_slots[i] = SLOTS - 1 - i;
+        }
+    }
+
+    /**
+     * @brief Leases the page containing the address for reading.
+     * @return The lease, empty if every slot is pinned.
+     */
+    ReadLease LeasePage(uint16_t address) { return ReadLease(Fetch(address - (address % PAGE_SIZE), false)); }
+
+    /**
+     * @brief Leases the page containing the address for reading and writing.
+     * @param full_page_write true if the caller overwrites the whole page, the page is not read then.
+     * @return The lease, empty if every slot is pinned.
+     */
+    WriteLease LeasePageWritable(uint16_t address, bool full_page_write = false)
+    {
+        return WriteLease(Fetch(address - (address % PAGE_SIZE), full_page_write));
+    }
+
+    void Read(void *data, uint16_t address, uint16_t data_size);
+    void Write(const void *data, uint16_t address, uint16_t data_size);
+
+    void Flush();
+    void Invalidate();
+
+    uint32_t Hits() const { return hits; }           /**< Page lookups served from the cache */
+    uint32_t Misses() const { return misses; }       /**< Page lookups that needed the EEPROM */
+    uint32_t Evictions() const { return evictions; } /**< Pages replaced to make room */
+
+    void ResetStatistics()
+    {
+        hits = 0;
+        misses = 0;
+        evictions = 0;
+    }
+
+private:
+    static constexpr uint8_t NONE = 0xFF;
+
+    struct Slot
+    {
+        bool valid;
+        bool dirty;
+        uint8_t pins;
+        uint16_t page_address;
+        uint8_t data[PAGE_SIZE];
+    };
+
+    Slot *Fetch(uint16_t page_address, bool full_page_write);
+    bool AllPinned() const;
+    void WriteBack(Slot &slot);
+
+    EepromM24C<model> &eeprom;
+    Policy<SLOTS, PAGES> policy;
+    Slot slots[SLOTS] = {};
+    uint8_t slot_of[PAGES];        // Device page -> slot, NONE if not cached
+    uint8_t free_slots[SLOTS];
+    uint8_t free_count = SLOTS;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+};
+
+// ========================================= Eeprom M24C Page Cache Implementation ==========================================
+
+/**
+ * @brief Reads data through the cache.
+ * @param data Pointer to the buffer to store the read data.
+ * @param address The EEPROM address to read from. Any alignment.
+ * @param data_size The size of the data.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+void EepromM24CPageCache<model, SLOTS, Policy>::Read(void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page_address = address - (address % PAGE_SIZE);
+        uint8_t offset = static_cast<uint8_t>(address - page_address);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+
+        Slot *slot = Fetch(page_address, false);
+
+        if (slot != nullptr)
+        {
+            memcpy(data, slot->data + offset, chunk);
+        }
+        else
+        {
+            eeprom.ReadBlock(data, address, chunk);
+        }
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Writes data into the cache. The EEPROM is updated on eviction or Flush.
+ * @param data Pointer to the data to write.
+ * @param address The EEPROM address to write to. Any alignment.
+ * @param data_size The size of the data.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+void EepromM24CPageCache<model, SLOTS, Policy>::Write(const void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page_address = address - (address % PAGE_SIZE);
+        uint8_t offset = static_cast<uint8_t>(address - page_address);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+
+        Slot *slot = Fetch(page_address, chunk == PAGE_SIZE);
+
+        if (slot != nullptr)
+        {
+            memcpy(slot->data + offset, data, chunk);
+            slot->dirty = true;
+        }
+        else
+        {
+            eeprom.WritePage(const_cast<uint8_t *>(data), address, chunk);
+        }
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Writes all dirty pages back to the EEPROM.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+void EepromM24CPageCache<model, SLOTS, Policy>::Flush()
+{
+    for (Slot &slot : slots)
+    {
+        WriteBack(slot);
+    }
+}
+
+/**
+ * @brief Drops all cached pages without writing them back, leased pages are kept.
+ * Call it after the EEPROM was modified behind the cache.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+void EepromM24CPageCache<model, SLOTS, Policy>::Invalidate()
+{
+    for (uint8_t i = 0; i < SLOTS; i++)
+    {
+        Slot &slot = slots[i];
+
+        if (slot.valid && slot.pins == 0)
+        {
+            policy.Removed(i);
+            slot_of[slot.page_address / PAGE_SIZE] = NONE;
+            slot.valid = false;
+            slot.dirty = false;
+            free_slots[free_count++] = i;
+        }
+    }
+}
+
+/**
+ * @brief Returns the slot holding the page. On a miss the page is loaded into a free slot or into the
+ * unpinned slot chosen by the policy.
+ * @param page_address The start address of the page.
+ * @param full_page_write true if the caller overwrites the whole page, the page is not read then.
+ * @return The slot, nullptr on a miss with every slot pinned.
+ */
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+typename EepromM24CPageCache<model, SLOTS, Policy>::Slot *EepromM24CPageCache<model, SLOTS, Policy>::Fetch(uint16_t page_address, bool full_page_write)
+{
+    uint16_t page = page_address / PAGE_SIZE;
+    uint8_t index = slot_of[page];
+
+    if (index != NONE)
+    {
+        hits++;
+        policy.Hit(index);
+        return &slots[index];
+    }
+
+    misses++;
+
+    // Only loads reach the policy, a miss that bypasses the cache must not shift its state
+    if (free_count == 0 && AllPinned())
+    {
+        return nullptr;
+    }
+
+    policy.Miss(page);
+
+    if (free_count > 0)
+    {
+        index = free_slots[--free_count];
+    }
+    else
+    {
+        index = policy.Victim(page, [this](uint8_t slot) { return slots[slot].pins != 0; });
+
+        if (index == NONE)
+        {
+            return nullptr;
+        }
+
+        uint16_t evicted_page = slots[index].page_address / PAGE_SIZE;
+
+        WriteBack(slots[index]);
+        policy.Evicted(index, evicted_page);
+        slot_of[evicted_page] = NONE;
+        evictions++;
+    }
+
+    Slot *victim = &slots[index];
+
+    WriteBack(*victim);
+
+    if (!full_page_write)
+    {
+        eeprom.ReadBlock(victim->data, page_address, PAGE_SIZE);
+    }
+
+    victim->valid = true;
+    victim->page_address = page_address;
+    slot_of[page] = index;
+    policy.Inserted(index, page);
+
+    return victim;
+}
+
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+bool EepromM24CPageCache<model, SLOTS, Policy>::AllPinned() const
+{
+    for (const Slot &slot : slots)
+    {
+        if (slot.pins == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <EepromM24CModel model, uint8_t SLOTS, template <uint8_t, uint16_t> class Policy>
+void EepromM24CPageCache<model, SLOTS, Policy>::WriteBack(Slot &slot)
+{
+    if (slot.valid && slot.dirty)
+    {
+        eeprom.WritePage(slot.data, slot.page_address, PAGE_SIZE);
+        slot.dirty = false;
+    }
+}
@@ -0,0 +1,321 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Page cache replacement policies
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+// ========================================= Index Lists ==========================================
+
+/**
+ * @brief Doubly linked lists over a fixed index space. An index is in at most one list at a time, the
+ * links are shared by all lists of the space.
+ * @tparam Index Index type, its maximum value marks the list ends.
+ * @tparam N Size of the index space.
+ */
+template <typename Index, uint16_t N>
+struct EepromM24CIndexLinks
+{
+    static constexpr Index END = static_cast<Index>(~static_cast<Index>(0));
+
+    struct List
+    {
+        Index head = END; // Most recent
+        Index tail = END; // Least recent
+        uint16_t size = 0;
+    };
+
+    Index previous[N];
+    Index next[N];
+
+    void PushFront(List &list, Index index)
+    {
+        previous[index] = END;
+        next[index] = list.head;
+
+        if (list.head != END)
+        {
+            previous[list.head] = index;
+        }
+        else
+        {
+            list.tail = index;
+        }
+
+        list.head = index;
+        list.size++;
+    }
+
+    void Remove(List &list, Index index)
+    {
+        if (previous[index] != END)
+        {
+            next[previous[index]] = next[index];
+        }
+        else
+        {
+            list.head = next[index];
+        }
+
+        if (next[index] != END)
+        {
+            previous[next[index]] = previous[index];
+        }
+        else
+        {
+            list.tail = previous[index];
+        }
+
+        list.size--;
+    }
+};
+
+/**
+ * @brief Smallest unsigned type indexing N entries with one value left for END.
+ */
+template <uint16_t N>
+using EepromM24CIndex = typename std::conditional<(N < 0xFF), uint8_t, uint16_t>::type;
+
+// ========================================= Replacement Policies ==========================================
+
+/*
+ * A policy tracks the cached pages by slot. The cache calls:
+ *   Miss(page)               on every miss that loads the page, before a slot is chosen
+ *   Victim(page, is_pinned)  when no slot is free and at least one is unpinned, returns the slot to evict
+ *   Evicted(slot, page)      after the page left the slot
+ *   Inserted(slot, page)     after the page was loaded into the slot
+ *   Hit(slot)                on every hit
+ *   Removed(slot)            when the slot is invalidated
+ * All operations are O(1), except that Victim steps over pinned slots.
+ */
+
+/**
+ * @brief Least recently used.
+ */
+template <uint8_t SLOTS, uint16_t PAGES>
+class EepromM24CLruPolicy
+{
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    void Miss(uint16_t page) { (void)page; }
+    void Hit(uint8_t slot) { Touch(slot); }
+    void Inserted(uint8_t slot, uint16_t page) { (void)page; links.PushFront(recency, slot); }
+    void Evicted(uint8_t slot, uint16_t page) { (void)page; links.Remove(recency, slot); }
+    void Removed(uint8_t slot) { links.Remove(recency, slot); }
+
+    template <typename IsPinned>
+    uint8_t Victim(uint16_t page, IsPinned is_pinned)
+    {
+        (void)page;
+
+        for (uint8_t slot = recency.tail; slot != Links::END; slot = links.previous[slot])
+        {
+            if (!is_pinned(slot))
+            {
+                return slot;
+            }
+        }
+
+        return NONE;
+    }
+
+private:
+    using Links = EepromM24CIndexLinks<uint8_t, SLOTS>;
+
+    void Touch(uint8_t slot)
+    {
+        links.Remove(recency, slot);
+        links.PushFront(recency, slot);
+    }
+
+    Links links;
+    typename Links::List recency;
+};
+
+/**
+ * @brief CLOCK (second chance): a hit sets the reference bit, the hand clears bits until it finds an unreferenced slot.
+ */
+template <uint8_t SLOTS, uint16_t PAGES>
+class EepromM24CClockPolicy
+{
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    void Miss(uint16_t page) { (void)page; }
+    void Hit(uint8_t slot) { referenced[slot] = true; }
+    void Inserted(uint8_t slot, uint16_t page) { (void)page; referenced[slot] = false; }
+    void Evicted(uint8_t slot, uint16_t page) { (void)slot; (void)page; }
+    void Removed(uint8_t slot) { referenced[slot] = false; }
+
+    template <typename IsPinned>
+    uint8_t Victim(uint16_t page, IsPinned is_pinned)
+    {
+        (void)page;
+
+        // Two sweeps: the first may only clear reference bits
+        for (uint16_t step = 0; step < 2 * SLOTS; step++)
+        {
+            uint8_t slot = hand;
+
+            hand = (hand + 1) % SLOTS;
+
+            if (is_pinned(slot))
+            {
+                continue;
+            }
+
+            if (!referenced[slot])
+            {
+                return slot;
+            }
+
+            referenced[slot] = false;
+        }
+
+        return NONE;
+    }
+
+private:
+    uint8_t hand = 0;
+    bool referenced[SLOTS] = {};
+};
+
+/**
+ * @brief Adaptive replacement cache. Pages seen once (T1) and pages seen again (T2) are kept in separate
+ * lists, recently evicted pages are remembered in the ghost lists B1 and B2. A hit in a ghost list shifts
+ * the target size of T1, so a one-pass scan only cycles through T1 and does not evict the pages of T2.
+ */
+template <uint8_t SLOTS, uint16_t PAGES>
+class EepromM24CArcPolicy
+{
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    void Miss(uint16_t page)
+    {
+        if (ghost[page] == B1)
+        {
+            uint16_t step = b1.size >= b2.size ? 1 : b2.size / b1.size;
+            target = target + step < SLOTS ? target + step : SLOTS;
+        }
+        else if (ghost[page] == B2)
+        {
+            uint16_t step = b2.size >= b1.size ? 1 : b1.size / b2.size;
+            target = target > step ? target - step : 0;
+        }
+    }
+
+    void Hit(uint8_t slot)
+    {
+        resident_links.Remove(list_of[slot] == T1 ? t1 : t2, slot);
+        resident_links.PushFront(t2, slot);
+        list_of[slot] = T2;
+    }
+
+    template <typename IsPinned>
+    uint8_t Victim(uint16_t page, IsPinned is_pinned)
+    {
+        bool from_t1 = t1.size > 0 && (t1.size > target || (ghost[page] == B2 && t1.size == target));
+        uint8_t slot = Oldest(from_t1 ? t1 : t2, is_pinned);
+
+        return slot != NONE ? slot : Oldest(from_t1 ? t2 : t1, is_pinned);
+    }
+
+    void Evicted(uint8_t slot, uint16_t page)
+    {
+        bool was_t1 = list_of[slot] == T1;
+
+        resident_links.Remove(was_t1 ? t1 : t2, slot);
+        list_of[slot] = NOT_RESIDENT;
+        ghost_links.PushFront(was_t1 ? b1 : b2, static_cast<PageIndex>(page));
+        ghost[page] = was_t1 ? B1 : B2;
+    }
+
+    void Inserted(uint8_t slot, uint16_t page)
+    {
+        uint8_t list = T1;
+
+        if (ghost[page] != NOT_GHOST)
+        {
+            ghost_links.Remove(ghost[page] == B1 ? b1 : b2, static_cast<PageIndex>(page));
+            ghost[page] = NOT_GHOST;
+            list = T2;
+        }
+
+        resident_links.PushFront(list == T1 ? t1 : t2, slot);
+        list_of[slot] = list;
+
+        // Directory bounds: |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+        while (b1.size > 0 && t1.size + b1.size > SLOTS)
+        {
+            DropGhost(b1);
+        }
+
+        while (b2.size > 0 && t1.size + t2.size + b1.size + b2.size > 2 * SLOTS)
+        {
+            DropGhost(b2);
+        }
+    }
+
+    void Removed(uint8_t slot)
+    {
+        resident_links.Remove(list_of[slot] == T1 ? t1 : t2, slot);
+        list_of[slot] = NOT_RESIDENT;
+    }
+
+private:
+    using PageIndex = EepromM24CIndex<PAGES>;
+    using ResidentLinks = EepromM24CIndexLinks<uint8_t, SLOTS>;
+    using GhostLinks = EepromM24CIndexLinks<PageIndex, PAGES>;
+
+    enum : uint8_t
+    {
+        NOT_RESIDENT = 0,
+        NOT_GHOST = 0,
+        T1 = 1,
+        T2 = 2,
+        B1 = 1,
+        B2 = 2,
+    };
+
+    template <typename IsPinned>
+    uint8_t Oldest(const typename ResidentLinks::List &list, IsPinned is_pinned)
+    {
+        for (uint8_t slot = list.tail; slot != ResidentLinks::END; slot = resident_links.previous[slot])
+        {
+            if (!is_pinned(slot))
+            {
+                return slot;
+            }
+        }
+
+        return NONE;
+    }
+
+    void DropGhost(typename GhostLinks::List &list)
+    {
+        PageIndex page = list.tail;
+
+        ghost_links.Remove(list, page);
+        ghost[page] = NOT_GHOST;
+    }
+
+    uint16_t target = 0; // Target size of T1
+    ResidentLinks resident_links;
+    typename ResidentLinks::List t1;
+    typename ResidentLinks::List t2;
+    uint8_t list_of[SLOTS] = {};
+    GhostLinks ghost_links;
+    typename GhostLinks::List b1;
+    typename GhostLinks::List b2;
+    uint8_t ghost[PAGES] = {};
+};
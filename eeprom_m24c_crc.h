@@ -0,0 +1,38 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - CRC helper
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-18
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Computes a CRC-16/CCITT-FALSE checksum (poly 0x1021) over a buffer.
+ * Bitwise implementation, no lookup table, so it costs no flash on small MCUs.
+ * @param data Pointer to the data to checksum.
+ * @param size The number of bytes to checksum.
+ * @param crc The running CRC value, allows chaining over several buffers.
+ * @return The updated CRC value.
+ */
+inline uint16_t EepromCrc16(const void *data_ptr, uint16_t size, uint16_t crc = 0xFFFF)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+
+    return crc;
+}
@@ -0,0 +1,367 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - AES-CTR encrypted region
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AES__)
+#include <wmmintrin.h>
+#endif
+
+#include "eeprom_m24c.h"
+
+// ========================================= AES-128 ==========================================
+
+/**
+ * @brief AES-128 block encryption (FIPS-197), the only direction CTR mode needs.
+ * Byte-oriented software implementation for the MCU, AES-NI when the host build enables it (-maes).
+ */
+class EepromAes128
+{
+public:
+    static constexpr uint8_t BLOCK_SIZE = 16;
+    static constexpr uint8_t KEY_SIZE = 16;
+
+    explicit EepromAes128(const uint8_t key[KEY_SIZE]) { ExpandKey(key); }
+
+    /**
+     * @brief Wipes the key schedule. Its first round key is the key itself.
+     */
+    ~EepromAes128()
+    {
+        volatile uint8_t *bytes = round_keys; // Volatile stores are not dropped as dead stores
+
+        for (uint16_t i = 0; i < sizeof(round_keys); i++)
+        {
+            bytes[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Encrypts a single block. Input and output may overlap.
+     */
+    void EncryptBlock(const uint8_t input[BLOCK_SIZE], uint8_t output[BLOCK_SIZE]) const
+    {
+#if defined(__AES__)
+        __m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input)), RoundKey(0));
+
+        for (uint8_t round = 1; round < ROUNDS; round++)
+        {
+            state = _mm_aesenc_si128(state, RoundKey(round));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_aesenclast_si128(state, RoundKey(ROUNDS)));
+#else
+        uint8_t state[BLOCK_SIZE];
+
+        for (uint8_t i = 0; i < BLOCK_SIZE; i++)
+        {
+            state[i] = input[i] ^ round_keys[i];
+        }
+
+        for (uint8_t round = 1; round <= ROUNDS; round++)
+        {
+            SubBytesShiftRows(state);
+
+            if (round < ROUNDS)
+            {
+                MixColumns(state);
+            }
+
+            for (uint8_t i = 0; i < BLOCK_SIZE; i++)
+            {
+                state[i] ^= round_keys[round * BLOCK_SIZE + i];
+            }
+        }
+
+        memcpy(output, state, BLOCK_SIZE);
+#endif
+    }
+
+private:
+    static constexpr uint8_t ROUNDS = 10;
+
+    static uint8_t SBox(uint8_t value)
+    {
+        static const uint8_t SBOX[256] = {
+            0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+            0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+            0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+            0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+            0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+            0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+            0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+            0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+            0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+            0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+            0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+            0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+            0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+            0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+            0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+            0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+        };
+
+        return SBOX[value];
+    }
+
+    static uint8_t Xtime(uint8_t value) { return static_cast<uint8_t>((value << 1) ^ ((value & 0x80) ? 0x1B : 0x00)); }
+
+    void ExpandKey(const uint8_t key[KEY_SIZE])
+    {
+        uint8_t rcon = 0x01;
+
+        memcpy(round_keys, key, KEY_SIZE);
+
+        for (uint8_t i = KEY_SIZE; i < sizeof(round_keys); i += 4)
+        {
+            uint8_t word[4] = {round_keys[i - 4], round_keys[i - 3], round_keys[i - 2], round_keys[i - 1]};
+
+            if (i % KEY_SIZE == 0) // RotWord, SubWord, Rcon
+            {
+                uint8_t first = word[0];
+
+                word[0] = SBox(word[1]) ^ rcon;
+                word[1] = SBox(word[2]);
+                word[2] = SBox(word[3]);
+                word[3] = SBox(first);
+                rcon = Xtime(rcon);
+            }
+
+            for (uint8_t j = 0; j < 4; j++)
+            {
+                round_keys[i + j] = round_keys[i + j - KEY_SIZE] ^ word[j];
+            }
+        }
+    }
+
+#if defined(__AES__)
+    __m128i RoundKey(uint8_t round) const { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(round_keys + round * BLOCK_SIZE)); }
+#else
+    static void SubBytesShiftRows(uint8_t state[BLOCK_SIZE])
+    {
+        uint8_t shifted[BLOCK_SIZE];
+
+        // The state is column-major, row r rotates left by r columns
+        for (uint8_t column = 0; column < 4; column++)
+        {
+            for (uint8_t row = 0; row < 4; row++)
+            {
+                shifted[column * 4 + row] = SBox(state[((column + row) % 4) * 4 + row]);
+            }
+        }
+
+        memcpy(state, shifted, BLOCK_SIZE);
+    }
+
+    static void MixColumns(uint8_t state[BLOCK_SIZE])
+    {
+        for (uint8_t column = 0; column < 4; column++)
+        {
+            uint8_t *c = state + column * 4;
+            uint8_t all = c[0] ^ c[1] ^ c[2] ^ c[3];
+            uint8_t first = c[0];
+
+            c[0] ^= all ^ Xtime(c[0] ^ c[1]);
+            c[1] ^= all ^ Xtime(c[1] ^ c[2]);
+            c[2] ^= all ^ Xtime(c[2] ^ c[3]);
+            c[3] ^= all ^ Xtime(c[3] ^ first);
+        }
+    }
+#endif
+
+    uint8_t round_keys[(ROUNDS + 1) * BLOCK_SIZE];
+};
+
+// ========================================= Eeprom M24C Encrypted ==========================================
+
+/**
+ * @brief Encrypted region with per-page AES-128-CTR nonces.
+ *
+ * Every page stores a 32-bit write counter followed by PAYLOAD_SIZE bytes of ciphertext:
+ *   [counter LE 32][ciphertext]
+ * The keystream of a page is derived from the counter block [page index BE 16][counter BE 32][0...][block],
+ * so a write re-encrypts only the pages it touches, each with a counter that was never used for that page
+ * before. A page is written in a single write cycle, counter and ciphertext change together.
+ *
+ * Reads fetch up to READ_PAGES pages per bus transaction and decrypt each chunk as it arrives.
+ *
+ * CTR gives confidentiality only, a modified ciphertext decrypts to modified plaintext without notice; pair
+ * the region with a CRC or MAC inside the payload where tampering matters. The counters restart when the
+ * region is erased, so erasing must come with a new key. Use a per-device key, the page index does not
+ * separate devices.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam READ_PAGES Pages read per bus transaction, sets the size of the read buffer on the stack.
+ */
+template <EepromM24CModel model, uint8_t READ_PAGES = 4>
+class EepromM24CEncrypted
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE; /**< Page size in bytes for the specified model */
+    static constexpr uint8_t COUNTER_SIZE = 4;                          /**< Write counter stored in front of each page */
+    static constexpr uint8_t PAYLOAD_SIZE = PAGE_SIZE - COUNTER_SIZE;    /**< Encrypted bytes per page */
+
+    static_assert(READ_PAGES > 0, "Encrypted region needs to read at least one page at a time");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param key The AES-128 key. The caller's copy is not referenced, but the key schedule derived from it,
+     * which begins with the key itself, stays in the object until it is destroyed and wiped.
+     * @param base_address Start of the region, must be page-aligned.
+     * @param pages Number of pages in the region.
+     */
+    EepromM24CEncrypted(EepromM24C<model> &eeprom_instance, const uint8_t key[EepromAes128::KEY_SIZE], uint16_t base_address, uint16_t pages)
+        : eeprom(eeprom_instance), aes(key), base(base_address), page_count(pages)
+    {
+    }
+
+    void Write(const void *data, uint16_t address, uint16_t data_size);
+    void Read(void *data, uint16_t address, uint16_t data_size);
+
+    /**
+     * @brief Capacity of the region in plaintext bytes.
+     */
+    uint16_t Size() const { return static_cast<uint16_t>(page_count * PAYLOAD_SIZE); }
+
+private:
+    void Crypt(uint16_t page, uint32_t counter, uint8_t offset, uint8_t *data, uint8_t size) const;
+
+    static uint32_t LoadCounter(const uint8_t *page_data)
+    {
+        return page_data[0] | (static_cast<uint32_t>(page_data[1]) << 8) | (static_cast<uint32_t>(page_data[2]) << 16) |
+               (static_cast<uint32_t>(page_data[3]) << 24);
+    }
+
+    uint16_t PageAddress(uint16_t page) const { return static_cast<uint16_t>(base + page * PAGE_SIZE); }
+
+    EepromM24C<model> &eeprom;
+    EepromAes128 aes;
+    uint16_t base;
+    uint16_t page_count;
+};
+
+// ========================================= Eeprom M24C Encrypted Implementation ==========================================
+
+/**
+ * @brief Encrypts and writes data. Each touched page costs one write cycle; pages written only in part are
+ * read and decrypted first, fully overwritten pages only have their counter read.
+ * @param data Pointer to the plaintext.
+ * @param address Plaintext offset inside the region. Any alignment.
+ * @param data_size The size of the data, address + data_size must not exceed Size().
+ */
+template <EepromM24CModel model, uint8_t READ_PAGES>
+void EepromM24CEncrypted<model, READ_PAGES>::Write(const void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page = address / PAYLOAD_SIZE;
+        uint8_t offset = static_cast<uint8_t>(address % PAYLOAD_SIZE);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAYLOAD_SIZE - offset ? data_size : PAYLOAD_SIZE - offset);
+        uint8_t page_data[PAGE_SIZE];
+
+        if (chunk == PAYLOAD_SIZE)
+        {
+            eeprom.ReadBlock(page_data, PageAddress(page), COUNTER_SIZE);
+        }
+        else
+        {
+            eeprom.ReadBlock(page_data, PageAddress(page), PAGE_SIZE);
+            Crypt(page, LoadCounter(page_data), 0, page_data + COUNTER_SIZE, PAYLOAD_SIZE);
+        }
+
+        uint32_t counter = LoadCounter(page_data) + 1; // An erased page reads 0xFFFFFFFF and starts at 0
+
+        page_data[0] = static_cast<uint8_t>(counter);
+        page_data[1] = static_cast<uint8_t>(counter >> 8);
+        page_data[2] = static_cast<uint8_t>(counter >> 16);
+        page_data[3] = static_cast<uint8_t>(counter >> 24);
+        memcpy(page_data + COUNTER_SIZE + offset, data, chunk);
+        Crypt(page, counter, 0, page_data + COUNTER_SIZE, PAYLOAD_SIZE);
+        eeprom.WritePage(page_data, PageAddress(page), PAGE_SIZE);
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Reads and decrypts data, READ_PAGES pages per bus transaction.
+ * @param data Pointer to the buffer to store the plaintext.
+ * @param address Plaintext offset inside the region. Any alignment.
+ * @param data_size The size of the data, address + data_size must not exceed Size().
+ */
+template <EepromM24CModel model, uint8_t READ_PAGES>
+void EepromM24CEncrypted<model, READ_PAGES>::Read(void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+    uint8_t buffer[READ_PAGES * PAGE_SIZE];
+
+    while (data_size > 0)
+    {
+        uint16_t first_page = address / PAYLOAD_SIZE;
+        uint16_t last_page = (address + data_size - 1) / PAYLOAD_SIZE;
+        uint16_t pages = last_page - first_page + 1 < READ_PAGES ? last_page - first_page + 1 : READ_PAGES;
+
+        eeprom.ReadBlock(buffer, PageAddress(first_page), static_cast<uint16_t>(pages * PAGE_SIZE));
+
+        for (uint16_t i = 0; i < pages; i++)
+        {
+            uint8_t *page_data = buffer + i * PAGE_SIZE;
+            uint8_t offset = static_cast<uint8_t>(address % PAYLOAD_SIZE);
+            uint8_t chunk = static_cast<uint8_t>(data_size < PAYLOAD_SIZE - offset ? data_size : PAYLOAD_SIZE - offset);
+
+            Crypt(first_page + i, LoadCounter(page_data), offset, page_data + COUNTER_SIZE + offset, chunk);
+            memcpy(data, page_data + COUNTER_SIZE + offset, chunk);
+
+            data += chunk;
+            address += chunk;
+            data_size -= chunk;
+        }
+    }
+}
+
+/**
+ * @brief XORs the keystream of a page version over part of its payload (encryption and decryption alike).
+ * Only the AES blocks covering [offset, offset + size) are computed.
+ */
+template <EepromM24CModel model, uint8_t READ_PAGES>
+void EepromM24CEncrypted<model, READ_PAGES>::Crypt(uint16_t page, uint32_t counter, uint8_t offset, uint8_t *data, uint8_t size) const
+{
+    uint8_t block[EepromAes128::BLOCK_SIZE] = {};
+    uint8_t keystream[EepromAes128::BLOCK_SIZE];
+    uint16_t page_index = static_cast<uint16_t>(base / PAGE_SIZE + page);
+
+    block[0] = static_cast<uint8_t>(page_index >> 8);
+    block[1] = static_cast<uint8_t>(page_index);
+    block[2] = static_cast<uint8_t>(counter >> 24);
+    block[3] = static_cast<uint8_t>(counter >> 16);
+    block[4] = static_cast<uint8_t>(counter >> 8);
+    block[5] = static_cast<uint8_t>(counter);
+
+    for (uint8_t i = 0; i < size;)
+    {
+        uint8_t position = offset + i;
+        uint8_t in_block = position % EepromAes128::BLOCK_SIZE;
+
+        block[EepromAes128::BLOCK_SIZE - 1] = position / EepromAes128::BLOCK_SIZE;
+        aes.EncryptBlock(block, keystream);
+
+        for (; in_block < EepromAes128::BLOCK_SIZE && i < size; in_block++, i++)
+        {
+            data[i] ^= keystream[in_block];
+        }
+    }
+}
@@ -0,0 +1,845 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Flash translation layer with wear leveling and snapshots
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Eeprom M24C FTL ==========================================
+
+/**
+ * @brief Logical-to-physical page mapping with dynamic and static wear leveling.
+ *
+ * Every logical page write is a single WritePage to the least-worn free physical page. Each physical page
+ * carries a header [logical page][sequence LE24][check] followed by PAYLOAD_SIZE bytes of user data; check
+ * is the CRC-16 of the rest of the page folded to one byte, so a torn page write is not replayed.
+ *
+ * The map and the per-page wear counters live in RAM and are persisted every CHECKPOINT_INTERVAL writes
+ * into one of two checkpoint slots at the start of the memory. Mount loads the newest checkpoint and
+ * replays the writes done after it, found by their sequence numbers in the page headers. The sequence
+ * continues across Format, so pages written before it are never replayed.
+ *
+ * Static wear leveling: every STATIC_INTERVAL writes, if the most-worn free page is more than WEAR_THRESHOLD
+ * cycles ahead of the coldest mapped page, the cold data is moved onto the worn page, releasing the fresh one.
+ *
+ * Wear counters are persisted relative to the least-worn page as one byte, so they saturate 255 cycles above it.
+ * Static wear leveling keeps the spread well below that. A page rewritten twice between two checkpoints is
+ * counted once after a reboot.
+ *
+ * Checkpoints and the snapshot record consume a sequence number each, like page writes: Mount takes the
+ * checkpoint slot with the newer sequence, and the snapshot state from the record only if the record lies
+ * in the replay window of that checkpoint, otherwise from the checkpoint.
+ *
+ * Snapshots: TakeSnapshot records the current sequence number in a single page. The first write of each
+ * logical page after the snapshot keeps the old physical page allocated ("held") instead of releasing it,
+ * so the cost of a snapshot scales with the pages modified after it. Rollback maps the held pages back and
+ * persists the map and the end of the snapshot with one checkpoint, no data page is copied. While a snapshot
+ * is active the held pages are not available as spares.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam LOGICAL_PAGES Number of logical pages exposed. The remaining data pages are spares.
+ * @tparam CHECKPOINT_INTERVAL Page writes between checkpoints.
+ * @tparam STATIC_INTERVAL Page writes between static wear leveling checks, 0 disables static wear leveling.
+ * @tparam WEAR_THRESHOLD Wear spread that triggers a cold page migration.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL = 128, uint16_t STATIC_INTERVAL = 16, uint8_t WEAR_THRESHOLD = 32>
+class EepromM24CFtl
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                          /**< Physical page size */
+    static constexpr uint8_t HEADER_SIZE = 5;                                                   /**< Logical page + 24-bit sequence + check */
+    static constexpr uint8_t PAYLOAD_SIZE = PAGE_SIZE - HEADER_SIZE;                            /**< User bytes per logical page */
+    static constexpr uint16_t PHYSICAL_PAGES = EepromM24C<model>::MEMORY_SIZE / PAGE_SIZE;      /**< Physical pages of the device */
+    static constexpr uint16_t CHECKPOINT_SIZE = 12 + 2 * LOGICAL_PAGES + PHYSICAL_PAGES + 2;    /**< Checkpoint record size */
+    static constexpr uint16_t CHECKPOINT_PAGES = (CHECKPOINT_SIZE + PAGE_SIZE - 1) / PAGE_SIZE; /**< Pages per checkpoint slot */
+    static constexpr uint16_t SNAPSHOT_PAGE = 2 * CHECKPOINT_PAGES;                             /**< Page holding the snapshot record */
+    static constexpr uint16_t FIRST_DATA_PAGE = SNAPSHOT_PAGE + 1;                              /**< Pages below hold FTL metadata */
+    static constexpr uint16_t DATA_PAGES = PHYSICAL_PAGES - FIRST_DATA_PAGE;                    /**< Pages available for data */
+
+    static_assert(PHYSICAL_PAGES <= 0xFF, "Physical page index is stored in one byte");
+    static_assert(LOGICAL_PAGES < 0xFE, "Logical page index is stored in one byte");
+    static_assert(LOGICAL_PAGES < DATA_PAGES, "FTL needs at least one spare physical page");
+    static_assert(CHECKPOINT_INTERVAL > 0 && CHECKPOINT_INTERVAL <= 0xFF, "Checkpoint interval must fit the replay window");
+
+    static constexpr uint8_t NONE = 0xFF; /**< Unmapped logical page / free physical page */
+    static constexpr uint8_t HELD = 0xFE; /**< Physical page kept for the snapshot / logical page unmapped in the snapshot */
+
+    EepromM24CFtl(EepromM24C<model> &eeprom_instance) : eeprom(eeprom_instance) {}
+
+    bool Mount();
+    void Format();
+
+    bool Write(uint8_t logical_page, const void *data);
+    void Read(uint8_t logical_page, void *data);
+
+    void Checkpoint();
+
+    bool TakeSnapshot();
+    void ReadSnapshot(uint8_t logical_page, void *data);
+    void Rollback();
+    void DiscardSnapshot();
+
+    /**
+     * @brief Indicates whether a snapshot is active.
+     */
+    bool IsSnapshotActive() const { return snapshot_active; }
+
+    /**
+     * @brief Write cycles counted for a physical page.
+     */
+    uint32_t Wear(uint8_t physical_page) const { return wear[physical_page]; }
+
+    /**
+     * @brief Physical page currently holding the logical page, NONE if it was never written.
+     */
+    uint8_t PhysicalPage(uint8_t logical_page) const { return map[logical_page]; }
+
+private:
+    static constexpr uint8_t CHECKPOINT_MAGIC = 0xC5;
+    static constexpr uint8_t SNAPSHOT_MAGIC = 0x5C;
+    static constexpr uint16_t MAP_OFFSET = 12;
+    static constexpr uint16_t HELD_OFFSET = MAP_OFFSET + LOGICAL_PAGES;
+    static constexpr uint16_t WEAR_OFFSET = HELD_OFFSET + LOGICAL_PAGES;
+    static constexpr uint32_t SEQUENCE_MASK = 0xFFFFFF;
+
+    static bool IsSequenceAfter(uint32_t a, uint32_t b) { return a != b && ((a - b) & SEQUENCE_MASK) < 0x800000; }
+    static uint16_t PageAddress(uint16_t physical_page) { return physical_page * PAGE_SIZE; }
+    static uint8_t PageCheck(const uint8_t *page);
+    static uint32_t PageSequence(const uint8_t *page) { return page[1] | (static_cast<uint32_t>(page[2]) << 8) | (static_cast<uint32_t>(page[3]) << 16); }
+
+    uint8_t CheckpointByte(uint16_t index, uint32_t base_wear) const;
+    bool ReadCheckpoint(uint8_t slot, bool load, uint32_t &checkpoint_sequence);
+    void WriteSnapshotRecord();
+    bool ReadSnapshotRecord(bool &active, uint32_t &snapshot_seq, uint32_t &record_seq);
+
+    uint8_t LeastWornFree() const;
+    uint8_t MostWornFree() const;
+    uint8_t ColdestMapped() const;
+    bool IsMigrationDue() const;
+
+    void Program(uint8_t physical_page, uint8_t logical_page, const uint8_t *payload);
+    void Apply(uint8_t physical_page, uint8_t logical_page);
+    void Migrate();
+    void ReleaseHeld();
+
+    EepromM24C<model> &eeprom;
+    uint32_t sequence = 0;               // Sequence of the last programmed page
+    uint16_t writes_since_checkpoint = 0;
+    uint8_t next_slot = 0;               // Checkpoint slot written next
+    uint8_t map[LOGICAL_PAGES];          // Logical -> physical
+    uint8_t owner[PHYSICAL_PAGES];       // Physical -> logical, NONE for free pages, HELD for snapshot pages
+    uint8_t held[LOGICAL_PAGES];         // Snapshot copy of a logical page modified after the snapshot, NONE if unmodified
+    bool snapshot_active = false;
+    uint32_t snapshot_sequence = 0;      // Sequence of the last page write before the snapshot
+    uint32_t wear[PHYSICAL_PAGES];
+    uint8_t page[PAGE_SIZE];
+};
+
+// ========================================= Eeprom M24C FTL Implementation ==========================================
+
+/**
+ * @brief Loads the newest checkpoint and replays the writes done after it. Formats an empty device.
+ * @return true if an existing FTL was mounted, false if the device was formatted.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Mount()
+{
+    uint32_t sequence_a = 0;
+    uint32_t sequence_b = 0;
+    bool valid_a = ReadCheckpoint(0, false, sequence_a);
+    bool valid_b = ReadCheckpoint(1, false, sequence_b);
+
+    if (!valid_a && !valid_b)
+    {
+        Format();
+        return false;
+    }
+
+    uint8_t slot = (valid_a && (!valid_b || IsSequenceAfter(sequence_a, sequence_b))) ? 0 : 1;
+
+    ReadCheckpoint(slot, true, sequence);
+    next_slot = slot ^ 1;
+    writes_since_checkpoint = 0;
+
+    bool record_active;
+    uint32_t record_snapshot_sequence;
+    uint32_t record_sequence;
+    uint32_t record_offset = 0;
+
+    if (ReadSnapshotRecord(record_active, record_snapshot_sequence, record_sequence))
+    {
+        record_offset = (record_sequence - sequence) & SEQUENCE_MASK;
+        record_offset = record_offset <= CHECKPOINT_INTERVAL ? record_offset : 0;
+    }
+
+    // The snapshot was taken or ended after the checkpoint: held pages of a discarded snapshot are free again
+    if (record_offset != 0)
+    {
+        if (!record_active || !snapshot_active || snapshot_sequence != record_snapshot_sequence)
+        {
+            ReleaseHeld();
+        }
+
+        snapshot_active = record_active;
+        snapshot_sequence = record_snapshot_sequence;
+    }
+
+    // Pages written after the checkpoint carry a sequence within the next CHECKPOINT_INTERVAL writes
+    uint8_t replay_offset[PHYSICAL_PAGES] = {};
+    uint8_t replay_logical[PHYSICAL_PAGES];
+    uint8_t newest_offset = 0;
+
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        eeprom.ReadBlock(page, PageAddress(p), HEADER_SIZE);
+
+        uint32_t offset = (PageSequence(page) - sequence) & SEQUENCE_MASK;
+
+        if (page[0] >= LOGICAL_PAGES || offset < 1 || offset > CHECKPOINT_INTERVAL)
+        {
+            continue;
+        }
+
+        // A torn write fails the check, the previous copy of the logical page stays mapped
+        eeprom.ReadBlock(page + HEADER_SIZE, PageAddress(p) + HEADER_SIZE, PAYLOAD_SIZE);
+
+        if (page[4] == PageCheck(page))
+        {
+            replay_offset[p] = static_cast<uint8_t>(offset);
+            replay_logical[p] = page[0];
+            newest_offset = replay_offset[p] > newest_offset ? replay_offset[p] : newest_offset;
+        }
+    }
+
+    uint32_t checkpoint_sequence = sequence;
+
+    for (uint16_t offset = 1; offset <= newest_offset; offset++)
+    {
+        for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+        {
+            if (replay_offset[p] == offset)
+            {
+                sequence = (checkpoint_sequence + offset - 1) & SEQUENCE_MASK;
+                Apply(static_cast<uint8_t>(p), replay_logical[p]);
+            }
+        }
+    }
+
+    // Writes overwritten before the reboot leave gaps in the replay, continue after the newest one
+    newest_offset = record_offset > newest_offset ? static_cast<uint8_t>(record_offset) : newest_offset;
+    sequence = (checkpoint_sequence + newest_offset) & SEQUENCE_MASK;
+    writes_since_checkpoint = newest_offset;
+
+    return true;
+}
+
+/**
+ * @brief Drops all logical pages and writes a fresh checkpoint. Wear history is lost.
+ * The sequence continues after the newest valid data page, so the old pages stay out of the replay window.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Format()
+{
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        eeprom.ReadBlock(page, PageAddress(p), PAGE_SIZE);
+
+        if (page[0] < LOGICAL_PAGES && page[4] == PageCheck(page) && IsSequenceAfter(PageSequence(page), sequence))
+        {
+            sequence = PageSequence(page);
+        }
+    }
+
+    memset(map, NONE, sizeof(map));
+    memset(owner, NONE, sizeof(owner));
+    memset(held, NONE, sizeof(held));
+    memset(wear, 0, sizeof(wear));
+    next_slot = 0;
+    snapshot_active = false;
+    snapshot_sequence = 0;
+
+    Checkpoint();
+    WriteSnapshotRecord();
+}
+
+/**
+ * @brief Writes a logical page with a single page write.
+ * @param logical_page The logical page index.
+ * @param data Pointer to PAYLOAD_SIZE bytes.
+ * @return false if no free page is left (all spares held by the snapshot), true otherwise.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Write(uint8_t logical_page, const void *data)
+{
+    if (IsMigrationDue())
+    {
+        Migrate();
+    }
+
+    uint8_t target = LeastWornFree();
+
+    if (target == NONE)
+    {
+        return false;
+    }
+
+    Program(target, logical_page, reinterpret_cast<const uint8_t *>(data));
+
+    return true;
+}
+
+/**
+ * @brief Reads a logical page. Pages never written read as 0xFF.
+ * @param logical_page The logical page index.
+ * @param data Pointer to a buffer of PAYLOAD_SIZE bytes.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Read(uint8_t logical_page, void *data)
+{
+    if (map[logical_page] == NONE)
+    {
+        memset(data, 0xFF, PAYLOAD_SIZE);
+        return;
+    }
+
+    eeprom.ReadBlock(data, PageAddress(map[logical_page]) + HEADER_SIZE, PAYLOAD_SIZE);
+}
+
+/**
+ * @brief Persists the map, the wear counters and the snapshot state into the older checkpoint slot.
+ * The checkpoint takes the next sequence number, so it is newer than everything written before it.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Checkpoint()
+{
+    uint32_t base_wear = 0xFFFFFFFF;
+
+    sequence = (sequence + 1) & SEQUENCE_MASK;
+
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        base_wear = wear[p] < base_wear ? wear[p] : base_wear;
+    }
+
+    uint16_t address = PageAddress(next_slot * CHECKPOINT_PAGES);
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t i = 0; i < CHECKPOINT_PAGES * PAGE_SIZE; i++)
+    {
+        uint8_t value;
+
+        if (i < CHECKPOINT_SIZE - 2)
+        {
+            value = CheckpointByte(i, base_wear);
+            crc = EepromCrc16(&value, 1, crc);
+        }
+        else if (i == CHECKPOINT_SIZE - 2)
+        {
+            value = static_cast<uint8_t>(crc);
+        }
+        else if (i == CHECKPOINT_SIZE - 1)
+        {
+            value = static_cast<uint8_t>(crc >> 8);
+        }
+        else
+        {
+            value = 0xFF;
+        }
+
+        page[i % PAGE_SIZE] = value;
+
+        if (i % PAGE_SIZE == PAGE_SIZE - 1)
+        {
+            eeprom.WritePage(page, address, PAGE_SIZE);
+            address += PAGE_SIZE;
+        }
+    }
+
+    next_slot ^= 1;
+    writes_since_checkpoint = 0;
+}
+
+/**
+ * @brief Serializes the checkpoint:
+ * [magic][sequence LE24][base wear LE32][snapshot active][snapshot sequence LE24][map][held][relative wear].
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+uint8_t EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::CheckpointByte(uint16_t index, uint32_t base_wear) const
+{
+    if (index == 0)
+    {
+        return CHECKPOINT_MAGIC;
+    }
+
+    if (index < 4)
+    {
+        return static_cast<uint8_t>(sequence >> (8 * (index - 1)));
+    }
+
+    if (index < 8)
+    {
+        return static_cast<uint8_t>(base_wear >> (8 * (index - 4)));
+    }
+
+    if (index == 8)
+    {
+        return snapshot_active ? 1 : 0;
+    }
+
+    if (index < MAP_OFFSET)
+    {
+        return static_cast<uint8_t>(snapshot_sequence >> (8 * (index - 9)));
+    }
+
+    if (index < HELD_OFFSET)
+    {
+        return map[index - MAP_OFFSET];
+    }
+
+    if (index < WEAR_OFFSET)
+    {
+        return held[index - HELD_OFFSET];
+    }
+
+    uint16_t physical_page = index - WEAR_OFFSET;
+
+    if (physical_page < FIRST_DATA_PAGE)
+    {
+        return 0;
+    }
+
+    return wear[physical_page] - base_wear > 0xFF ? 0xFF : static_cast<uint8_t>(wear[physical_page] - base_wear);
+}
+
+/**
+ * @brief Validates a checkpoint slot and optionally loads it into RAM.
+ * @param slot Checkpoint slot, 0 or 1.
+ * @param load true to load the map and the wear counters.
+ * @param checkpoint_sequence Receives the sequence stored in the checkpoint.
+ * @return true if the slot holds a valid checkpoint.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::ReadCheckpoint(uint8_t slot, bool load, uint32_t &checkpoint_sequence)
+{
+    uint16_t address = PageAddress(slot * CHECKPOINT_PAGES);
+    uint16_t crc = 0xFFFF;
+    uint16_t stored_crc = 0;
+    uint32_t base_wear = 0;
+
+    checkpoint_sequence = 0;
+
+    if (load)
+    {
+        memset(owner, NONE, sizeof(owner));
+        memset(wear, 0, sizeof(wear));
+        snapshot_sequence = 0;
+    }
+
+    for (uint16_t i = 0; i < CHECKPOINT_SIZE; i++)
+    {
+        if (i % PAGE_SIZE == 0)
+        {
+            eeprom.ReadBlock(page, address + i, PAGE_SIZE);
+        }
+
+        uint8_t value = page[i % PAGE_SIZE];
+
+        if (i == 0 && value != CHECKPOINT_MAGIC)
+        {
+            return false;
+        }
+
+        if (i < CHECKPOINT_SIZE - 2)
+        {
+            crc = EepromCrc16(&value, 1, crc);
+        }
+        else
+        {
+            stored_crc |= static_cast<uint16_t>(value) << (8 * (i - (CHECKPOINT_SIZE - 2)));
+        }
+
+        if (i >= 1 && i < 4)
+        {
+            checkpoint_sequence |= static_cast<uint32_t>(value) << (8 * (i - 1));
+        }
+        else if (i >= 4 && i < 8)
+        {
+            base_wear |= static_cast<uint32_t>(value) << (8 * (i - 4));
+        }
+        else if (load && i == 8)
+        {
+            snapshot_active = value == 1;
+        }
+        else if (load && i > 8 && i < MAP_OFFSET)
+        {
+            snapshot_sequence |= static_cast<uint32_t>(value) << (8 * (i - 9));
+        }
+        else if (load && i >= MAP_OFFSET && i < HELD_OFFSET)
+        {
+            map[i - MAP_OFFSET] = value;
+        }
+        else if (load && i >= HELD_OFFSET && i < WEAR_OFFSET)
+        {
+            held[i - HELD_OFFSET] = value;
+        }
+        else if (load && i >= WEAR_OFFSET && i < CHECKPOINT_SIZE - 2)
+        {
+            uint16_t physical_page = i - WEAR_OFFSET;
+
+            wear[physical_page] = physical_page < FIRST_DATA_PAGE ? 0 : base_wear + value;
+        }
+    }
+
+    if (load)
+    {
+        for (uint8_t l = 0; l < LOGICAL_PAGES; l++)
+        {
+            if (map[l] != NONE)
+            {
+                owner[map[l]] = l;
+            }
+
+            if (held[l] != NONE && held[l] != HELD)
+            {
+                owner[held[l]] = HELD;
+            }
+        }
+    }
+
+    return crc == stored_crc;
+}
+
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+uint8_t EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::LeastWornFree() const
+{
+    uint8_t best = NONE;
+
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        if (owner[p] == NONE && (best == NONE || wear[p] < wear[best]))
+        {
+            best = static_cast<uint8_t>(p);
+        }
+    }
+
+    return best;
+}
+
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+uint8_t EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::MostWornFree() const
+{
+    uint8_t best = NONE;
+
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        if (owner[p] == NONE && (best == NONE || wear[p] > wear[best]))
+        {
+            best = static_cast<uint8_t>(p);
+        }
+    }
+
+    return best;
+}
+
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+uint8_t EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::ColdestMapped() const
+{
+    uint8_t best = NONE;
+
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        // Pages shared with the snapshot are not migrated, moving them would hold an extra copy
+        bool shared = snapshot_active && owner[p] < LOGICAL_PAGES && held[owner[p]] == NONE;
+
+        if (owner[p] < LOGICAL_PAGES && !shared && (best == NONE || wear[p] < wear[best]))
+        {
+            best = static_cast<uint8_t>(p);
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Static wear leveling decision for the next page write.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::IsMigrationDue() const
+{
+    if (STATIC_INTERVAL == 0 || ((sequence + 1) & SEQUENCE_MASK) % STATIC_INTERVAL != 0)
+    {
+        return false;
+    }
+
+    uint8_t worn = MostWornFree();
+    uint8_t cold = ColdestMapped();
+
+    return worn != NONE && cold != NONE && wear[worn] > wear[cold] + WEAR_THRESHOLD;
+}
+
+/**
+ * @brief Writes header and payload to a physical page and updates the map.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Program(uint8_t physical_page, uint8_t logical_page, const uint8_t *payload)
+{
+    uint32_t next_sequence = (sequence + 1) & SEQUENCE_MASK;
+
+    if (payload != page + HEADER_SIZE)
+    {
+        memcpy(page + HEADER_SIZE, payload, PAYLOAD_SIZE);
+    }
+
+    page[0] = logical_page;
+    page[1] = static_cast<uint8_t>(next_sequence);
+    page[2] = static_cast<uint8_t>(next_sequence >> 8);
+    page[3] = static_cast<uint8_t>(next_sequence >> 16);
+    page[4] = PageCheck(page);
+
+    eeprom.WritePage(page, PageAddress(physical_page), PAGE_SIZE);
+    Apply(physical_page, logical_page);
+
+    if (writes_since_checkpoint >= CHECKPOINT_INTERVAL)
+    {
+        Checkpoint();
+    }
+}
+
+/**
+ * @brief CRC-16 of logical page, sequence and payload, folded to one byte.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+uint8_t EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::PageCheck(const uint8_t *page)
+{
+    uint16_t crc = EepromCrc16(page, 4);
+
+    crc = EepromCrc16(page + HEADER_SIZE, PAYLOAD_SIZE, crc);
+
+    return static_cast<uint8_t>(crc ^ (crc >> 8));
+}
+
+/**
+ * @brief Updates the RAM state after a page write. Shared by Program and the Mount replay.
+ * The first write of a logical page after the snapshot holds the previous page instead of releasing it.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Apply(uint8_t physical_page, uint8_t logical_page)
+{
+    // During replay the page may still be mapped to a logical page whose newer copy was overwritten,
+    // that logical page is remapped by a later write in the replay
+    if (owner[physical_page] < LOGICAL_PAGES && owner[physical_page] != logical_page)
+    {
+        map[owner[physical_page]] = NONE;
+    }
+
+    uint32_t next_sequence = (sequence + 1) & SEQUENCE_MASK;
+    bool first_since_snapshot = snapshot_active && held[logical_page] == NONE && IsSequenceAfter(next_sequence, snapshot_sequence);
+
+    if (first_since_snapshot)
+    {
+        held[logical_page] = map[logical_page] == NONE ? HELD : map[logical_page];
+    }
+
+    if (map[logical_page] != NONE && owner[map[logical_page]] == logical_page)
+    {
+        owner[map[logical_page]] = first_since_snapshot ? HELD : NONE;
+    }
+
+    map[logical_page] = physical_page;
+    owner[physical_page] = logical_page;
+    wear[physical_page]++;
+    sequence = next_sequence;
+    writes_since_checkpoint++;
+}
+
+/**
+ * @brief Moves the coldest mapped page onto the most-worn free page.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Migrate()
+{
+    uint8_t cold = ColdestMapped();
+    uint8_t target = MostWornFree();
+
+    eeprom.ReadBlock(page + HEADER_SIZE, PageAddress(cold) + HEADER_SIZE, PAYLOAD_SIZE);
+    Program(target, owner[cold], page + HEADER_SIZE);
+}
+
+/**
+ * @brief Takes a snapshot of all logical pages. Costs a single page write.
+ * @return false if a snapshot is already active, true otherwise.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::TakeSnapshot()
+{
+    if (snapshot_active)
+    {
+        return false;
+    }
+
+    memset(held, NONE, sizeof(held));
+    snapshot_active = true;
+    snapshot_sequence = sequence;
+    WriteSnapshotRecord();
+
+    return true;
+}
+
+/**
+ * @brief Reads a logical page as it was when the snapshot was taken.
+ * @param logical_page The logical page index.
+ * @param data Pointer to a buffer of PAYLOAD_SIZE bytes.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::ReadSnapshot(uint8_t logical_page, void *data)
+{
+    if (!snapshot_active || held[logical_page] == NONE)
+    {
+        Read(logical_page, data);
+    }
+    else if (held[logical_page] == HELD)
+    {
+        memset(data, 0xFF, PAYLOAD_SIZE);
+    }
+    else
+    {
+        eeprom.ReadBlock(data, PageAddress(held[logical_page]) + HEADER_SIZE, PAYLOAD_SIZE);
+    }
+}
+
+/**
+ * @brief Restores all logical pages to the snapshot and ends it.
+ * Only metadata is written: one checkpoint, which also records the end of the snapshot, so the rollback
+ * takes effect atomically. The snapshot record left behind is older than the checkpoint and ignored.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::Rollback()
+{
+    if (!snapshot_active)
+    {
+        return;
+    }
+
+    for (uint8_t l = 0; l < LOGICAL_PAGES; l++)
+    {
+        if (held[l] == NONE)
+        {
+            continue;
+        }
+
+        if (map[l] != NONE)
+        {
+            owner[map[l]] = NONE;
+        }
+
+        map[l] = held[l] == HELD ? NONE : held[l];
+
+        if (map[l] != NONE)
+        {
+            owner[map[l]] = l;
+        }
+    }
+
+    memset(held, NONE, sizeof(held));
+    snapshot_active = false;
+
+    Checkpoint();
+}
+
+/**
+ * @brief Ends the snapshot and releases the held pages. Costs a single page write.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::DiscardSnapshot()
+{
+    if (!snapshot_active)
+    {
+        return;
+    }
+
+    ReleaseHeld();
+    snapshot_active = false;
+    WriteSnapshotRecord();
+}
+
+/**
+ * @brief Frees the pages held for the snapshot.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::ReleaseHeld()
+{
+    for (uint16_t p = FIRST_DATA_PAGE; p < PHYSICAL_PAGES; p++)
+    {
+        owner[p] = owner[p] == HELD ? NONE : owner[p];
+    }
+
+    memset(held, NONE, sizeof(held));
+}
+
+/**
+ * @brief Writes the snapshot record: [magic][active][snapshot sequence LE24][record sequence LE24][crc LE16].
+ * The record takes the next sequence number and counts towards the checkpoint interval like a page write.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+void EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::WriteSnapshotRecord()
+{
+    uint8_t record[10];
+
+    sequence = (sequence + 1) & SEQUENCE_MASK;
+    writes_since_checkpoint++;
+
+    record[0] = SNAPSHOT_MAGIC;
+    record[1] = snapshot_active ? 1 : 0;
+    record[2] = static_cast<uint8_t>(snapshot_sequence);
+    record[3] = static_cast<uint8_t>(snapshot_sequence >> 8);
+    record[4] = static_cast<uint8_t>(snapshot_sequence >> 16);
+    record[5] = static_cast<uint8_t>(sequence);
+    record[6] = static_cast<uint8_t>(sequence >> 8);
+    record[7] = static_cast<uint8_t>(sequence >> 16);
+
+    uint16_t crc = EepromCrc16(record, 8);
+
+    record[8] = static_cast<uint8_t>(crc);
+    record[9] = static_cast<uint8_t>(crc >> 8);
+
+    eeprom.WritePage(record, PageAddress(SNAPSHOT_PAGE), sizeof(record));
+
+    if (writes_since_checkpoint >= CHECKPOINT_INTERVAL)
+    {
+        Checkpoint();
+    }
+}
+
+/**
+ * @brief Reads the snapshot record.
+ * @return false if the record is missing or damaged, true otherwise.
+ */
+template <EepromM24CModel model, uint8_t LOGICAL_PAGES, uint16_t CHECKPOINT_INTERVAL, uint16_t STATIC_INTERVAL, uint8_t WEAR_THRESHOLD>
+bool EepromM24CFtl<model, LOGICAL_PAGES, CHECKPOINT_INTERVAL, STATIC_INTERVAL, WEAR_THRESHOLD>::ReadSnapshotRecord(bool &active, uint32_t &snapshot_seq, uint32_t &record_seq)
+{
+    uint8_t record[10];
+
+    eeprom.ReadBlock(record, PageAddress(SNAPSHOT_PAGE), sizeof(record));
+
+    if (record[0] != SNAPSHOT_MAGIC || EepromCrc16(record, 8) != static_cast<uint16_t>(record[8] | (record[9] << 8)))
+    {
+        return false;
+    }
+
+    active = record[1] == 1;
+    snapshot_seq = record[2] | (static_cast<uint32_t>(record[3]) << 8) | (static_cast<uint32_t>(record[4]) << 16);
+    record_seq = record[5] | (static_cast<uint32_t>(record[6]) << 8) | (static_cast<uint32_t>(record[7]) << 16);
+
+    return true;
+}
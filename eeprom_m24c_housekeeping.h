@@ -0,0 +1,358 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Idle-time housekeeping scheduler
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_timing.h"
+#include "eeprom_m24c_writeback.h"
+
+// ========================================= Housekeeping Task ==========================================
+
+/**
+ * @brief Background work split into page-sized steps: one page read or write per step, so a foreground
+ * operation waits for at most one step when it preempts the scheduler.
+ */
+class EepromM24CHousekeepingTask
+{
+public:
+    /**
+     * @brief true while the task has work waiting.
+     */
+    virtual bool Pending() = 0;
+
+    /**
+     * @brief Runs one step.
+     * @return Estimated bus time of the step in microseconds, write cycle included: the work done at the
+     * slowest clock the driver used during the step, failed attempts not included.
+     */
+    virtual uint32_t Step() = 0;
+
+    /**
+     * @brief Bus time of one step at the driver's current clock without failed attempts, the scheduler
+     * only starts steps that fit.
+     */
+    virtual uint32_t StepCostUs() = 0;
+};
+
+/**
+ * @brief Bus time of page-sized steps for a model and bus speed, without retries.
+ */
+template <EepromM24CModel model>
+struct EepromM24CStepCost
+{
+    /**
+     * @brief Clock the driver runs at: the step of its bus speed policy, bus_hz without a policy.
+     */
+    static uint32_t BusHz(const EepromM24C<model> &eeprom, uint32_t bus_hz) { return eeprom.BusSpeed() != 0 ? eeprom.BusSpeed() : bus_hz; }
+
+    static uint32_t PageReadUs(uint32_t bus_hz)
+    {
+        return static_cast<uint32_t>(EepromM24CTiming<model>::ReadNs({bus_hz, 1, false, false}, EepromM24C<model>::PAGE_SIZE) / 1000 + 1);
+    }
+
+    static uint32_t PageWriteUs(uint32_t bus_hz)
+    {
+        return static_cast<uint32_t>(EepromM24CTiming<model>::WritePageNs({bus_hz, 1, false, false}, EepromM24C<model>::PAGE_SIZE) / 1000 + 1) +
+               EepromM24C<model>::WRITE_CYCLE_TIME_US;
+    }
+};
+
+// ========================================= Eeprom M24C Housekeeping ==========================================
+
+/**
+ * @brief Runs housekeeping tasks in idle windows reported by the application.
+ *
+ * RunIdle() serves the pending tasks round robin, one step at a time, as long as the next step fits both
+ * the rest of the window and the task's bus time cap for the window. Step costs follow the clock of an
+ * adaptive bus speed, retries after bus errors are not accounted for. Preempt() (e.g. from the interrupt
+ * that brings foreground work) ends the window after the running step.
+ *
+ * @tparam TASKS Maximum number of registered tasks.
+ */
+template <uint8_t TASKS>
+class EepromM24CHousekeeping
+{
+public:
+    static_assert(TASKS > 0, "Housekeeping needs at least one task slot");
+
+    bool Add(EepromM24CHousekeepingTask &task, uint32_t cap_us);
+    uint32_t RunIdle(uint32_t idle_us);
+
+    /**
+     * @brief Ends the running idle window after the current step. Safe to call from an interrupt.
+     */
+    void Preempt() { preempted = true; }
+
+    /**
+     * @brief true while any task has work waiting.
+     */
+    bool Pending() const;
+
+    /**
+     * @brief Steps run by a task since it was added, in order of Add().
+     */
+    uint32_t Steps(uint8_t index) const { return entries[index].steps; }
+
+private:
+    struct Entry
+    {
+        EepromM24CHousekeepingTask *task;
+        uint32_t cap_us; // Bus time per idle window
+        uint32_t steps;
+    };
+
+    Entry entries[TASKS] = {};
+    uint8_t count = 0;
+    uint8_t next = 0; // Task served first in the next window, so a capped window does not starve the later tasks
+    volatile bool preempted = false;
+};
+
+// ========================================= Eeprom M24C Housekeeping Implementation ==========================================
+
+/**
+ * @brief Registers a task.
+ * @param task The task, must outlive the scheduler.
+ * @param cap_us Bus time the task may use per idle window. A cap below StepCostUs() never lets the task run.
+ * @return false if all task slots are taken.
+ */
+template <uint8_t TASKS>
+bool EepromM24CHousekeeping<TASKS>::Add(EepromM24CHousekeepingTask &task, uint32_t cap_us)
+{
+    if (count == TASKS)
+    {
+        return false;
+    }
+
+    entries[count++] = {&task, cap_us, 0};
+    return true;
+}
+
+/**
+ * @brief Runs steps for the length of an idle window.
+ * @param idle_us Bus time available before foreground work is expected.
+ * @return The bus time used.
+ */
+template <uint8_t TASKS>
+uint32_t EepromM24CHousekeeping<TASKS>::RunIdle(uint32_t idle_us)
+{
+    uint32_t used[TASKS] = {};
+    uint32_t total = 0;
+    uint8_t stalled = 0; // Tasks in a row that could not run
+
+    preempted = false;
+
+    while (count > 0 && stalled < count && !preempted)
+    {
+        Entry &entry = entries[next];
+        uint32_t cost = entry.task->StepCostUs();
+
+        if (entry.task->Pending() && total + cost <= idle_us && used[next] + cost <= entry.cap_us)
+        {
+            uint32_t spent = entry.task->Step();
+
+            used[next] += spent;
+            total += spent;
+            entry.steps++;
+            stalled = 0;
+        }
+        else
+        {
+            stalled++;
+        }
+
+        next = static_cast<uint8_t>((next + 1) % count);
+    }
+
+    return total;
+}
+
+template <uint8_t TASKS>
+bool EepromM24CHousekeeping<TASKS>::Pending() const
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (entries[i].task->Pending())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ========================================= Housekeeping Tasks ==========================================
+
+/**
+ * @brief Lazy erasure: pages queued by the foreground are erased in idle time, one page per step.
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam QUEUE Maximum number of queued pages.
+ */
+template <EepromM24CModel model, uint8_t QUEUE>
+class EepromM24CEraseTask : public EepromM24CHousekeepingTask
+{
+public:
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param bus_hz Bus clock used to estimate the step cost while the driver has no bus speed policy.
+     */
+    EepromM24CEraseTask(EepromM24C<model> &eeprom_instance, uint32_t bus_hz = 400000)
+        : eeprom(eeprom_instance), default_hz(bus_hz) {}
+
+    /**
+     * @brief Queues a page for erasure.
+     * @param page_address The start address of the page.
+     * @return false if the queue is full, the caller erases the page itself then.
+     */
+    bool Schedule(uint16_t page_address)
+    {
+        if (size == QUEUE)
+        {
+            return false;
+        }
+
+        queue[(head + size++) % QUEUE] = page_address;
+        return true;
+    }
+
+    bool Pending() override { return size > 0; }
+    uint32_t StepCostUs() override { return EepromM24CStepCost<model>::PageWriteUs(EepromM24CStepCost<model>::BusHz(eeprom, default_hz)); }
+
+    uint32_t Step() override
+    {
+        uint32_t cost = StepCostUs();
+
+        eeprom.ErasePage(queue[head]);
+        head = static_cast<uint8_t>((head + 1) % QUEUE);
+        size--;
+
+        uint32_t cost_after = StepCostUs(); // The driver may have stepped the clock down during the step
+
+        return cost_after > cost ? cost_after : cost;
+    }
+
+private:
+    EepromM24C<model> &eeprom;
+    uint32_t default_hz;
+    uint16_t queue[QUEUE];
+    uint8_t head = 0;
+    uint8_t size = 0;
+};
+
+/**
+ * @brief Scrubbing: reads a region page by page in endless rounds and rewrites the pages the check
+ * rejects, so weak or corrupted pages are found and refreshed before the data is needed.
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam Check Callable as bool(uint16_t page_address, uint8_t *page). Returns true if the page is to be
+ * rewritten with the (possibly repaired) contents of page.
+ */
+template <EepromM24CModel model, typename Check>
+class EepromM24CScrubTask : public EepromM24CHousekeepingTask
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE; /**< Page size in bytes for the specified model */
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param base_address Start of the region, must be page-aligned.
+     * @param pages Number of pages in the region.
+     * @param check The page check.
+     * @param bus_hz Bus clock used to estimate the step cost while the driver has no bus speed policy.
+     */
+    EepromM24CScrubTask(EepromM24C<model> &eeprom_instance, uint16_t base_address, uint16_t pages, Check check, uint32_t bus_hz = 400000)
+        : eeprom(eeprom_instance), base(base_address), page_count(pages), checker(check), default_hz(bus_hz) {}
+
+    bool Pending() override { return page_count > 0; }
+
+    uint32_t StepCostUs() override
+    {
+        uint32_t bus_hz = EepromM24CStepCost<model>::BusHz(eeprom, default_hz);
+
+        return EepromM24CStepCost<model>::PageReadUs(bus_hz) + EepromM24CStepCost<model>::PageWriteUs(bus_hz);
+    }
+
+    uint32_t Step() override
+    {
+        uint8_t page[PAGE_SIZE];
+        uint16_t page_address = static_cast<uint16_t>(base + cursor * PAGE_SIZE);
+        uint32_t bus_hz = EepromM24CStepCost<model>::BusHz(eeprom, default_hz);
+        bool rewritten = false;
+
+        eeprom.ReadBlock(page, page_address, PAGE_SIZE);
+
+        if (checker(page_address, page))
+        {
+            eeprom.WritePage(page, page_address, PAGE_SIZE);
+            rewritten = true;
+            repaired++;
+        }
+
+        cursor = static_cast<uint16_t>((cursor + 1) % page_count);
+
+        // Charged at the slowest clock of the step, the driver may have stepped down during it
+        uint32_t bus_hz_after = EepromM24CStepCost<model>::BusHz(eeprom, default_hz);
+
+        bus_hz = bus_hz_after < bus_hz ? bus_hz_after : bus_hz;
+
+        return EepromM24CStepCost<model>::PageReadUs(bus_hz) + (rewritten ? EepromM24CStepCost<model>::PageWriteUs(bus_hz) : 0);
+    }
+
+    /**
+     * @brief Pages rewritten so far.
+     */
+    uint32_t Repaired() const { return repaired; }
+
+private:
+    EepromM24C<model> &eeprom;
+    uint16_t base;
+    uint16_t page_count;
+    Check checker;
+    uint32_t default_hz;
+    uint16_t cursor = 0;
+    uint32_t repaired = 0;
+};
+
+/**
+ * @brief Drains a write-back buffer in idle time, one page per step in epoch order.
+ * Foreground writes only land in RAM; the buffer flushes inline only when it runs out of slots.
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam SLOTS Slots of the write-back buffer.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+class EepromM24CWriteBackTask : public EepromM24CHousekeepingTask
+{
+public:
+    /**
+     * @param buffer_instance The write-back buffer.
+     * @param bus_hz Bus clock used to estimate the step cost while the driver has no bus speed policy.
+     */
+    EepromM24CWriteBackTask(EepromM24CWriteBack<model, SLOTS> &buffer_instance, uint32_t bus_hz = 400000)
+        : buffer(buffer_instance), default_hz(bus_hz) {}
+
+    bool Pending() override { return buffer.DirtyPages() > 0; }
+    uint32_t StepCostUs() override { return EepromM24CStepCost<model>::PageWriteUs(EepromM24CStepCost<model>::BusHz(buffer.Driver(), default_hz)); }
+
+    uint32_t Step() override
+    {
+        uint32_t cost = StepCostUs();
+
+        buffer.FlushPage();
+
+        uint32_t cost_after = StepCostUs(); // The driver may have stepped the clock down during the step
+
+        return cost_after > cost ? cost_after : cost;
+    }
+
+private:
+    EepromM24CWriteBack<model, SLOTS> &buffer;
+    uint32_t default_hz;
+};
@@ -0,0 +1,366 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Circular record log
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Eeprom M24C Log ==========================================
+
+/**
+ * @brief Circular log of variable-length records packed across page boundaries.
+ *
+ * Records are stored as [length][bytes] back to back, a record continues on the next page when it does not
+ * fit. Every page starts with a header:
+ *   [sequence LE 16][continuation][check]
+ * continuation is the number of bytes at the start of the payload that belong to a record begun on an earlier
+ * page, so a reader can resynchronise at any page. check is the CRC-16 of sequence, continuation and payload
+ * folded to 8 bits. Unused payload bytes are 0xFF, which is why a record holds at most 254 bytes.
+ *
+ * The tail page is assembled in RAM and written once it is full; Flush() writes it early. A page that fails
+ * its check is skipped together with the records crossing it, the records after it are still read. Power
+ * loss while Flush() rewrites a partly filled tail page can lose the records of that page.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam PAGES Number of pages in the ring.
+ * @tparam MAX_RECORD_SIZE Largest record Read() can return, sets the size of its buffer on the stack.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE = 64>
+class EepromM24CLog
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE; /**< Page size in bytes for the specified model */
+    static constexpr uint8_t HEADER_SIZE = 4;                           /**< Page header size */
+    static constexpr uint8_t PAYLOAD_SIZE = PAGE_SIZE - HEADER_SIZE;    /**< Record bytes per page */
+
+    static_assert(PAGES >= 2, "The ring needs at least two pages");
+    static_assert(static_cast<uint32_t>(PAGES) * PAGE_SIZE <= EepromM24C<model>::MEMORY_SIZE, "Log exceeds the memory size");
+    static_assert(MAX_RECORD_SIZE > 0 && MAX_RECORD_SIZE < 0xFF, "Records hold 1 to 254 bytes");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param base_address Start address of the ring. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CLog(EepromM24C<model> &eeprom_instance, uint16_t base_address) : eeprom(eeprom_instance), base(base_address) {}
+
+    void Mount();
+    bool Append(const void *data, uint8_t data_size);
+    void Flush();
+
+    template <typename Callback>
+    uint16_t Read(Callback callback);
+
+    /**
+     * @brief Number of pages holding records, the tail page included.
+     */
+    uint16_t UsedPages() const { return stored_pages + (tail_used > 0 ? 1 : 0); }
+
+private:
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    uint16_t PageAddress(uint16_t slot) const { return base + slot * PAGE_SIZE; }
+
+    static uint8_t PageCheck(const uint8_t *page);
+    bool LoadPage(uint16_t slot, uint8_t *page);
+    void Put(uint8_t value);
+    void Advance();
+
+    EepromM24C<model> &eeprom;
+    uint16_t base;
+    uint16_t tail_slot = 0;    // Ring slot of the page assembled in RAM
+    uint16_t sequence = 0;     // Sequence of the tail page
+    uint16_t stored_pages = 0; // Written pages before the tail, oldest first
+    uint8_t tail_used = 0;     // Used payload bytes of the tail page
+    bool tail_dirty = false;   // The tail page differs from the EEPROM
+    uint8_t tail[PAGE_SIZE];
+};
+
+// ========================================= Eeprom M24C Log Implementation ==========================================
+
+/**
+ * @brief Finds the newest valid page and resumes appending after its last record.
+ * An empty or unreadable ring starts over at the first page.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+void EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Mount()
+{
+    bool found = false;
+    uint16_t newest_slot = 0;
+    uint16_t newest_sequence = 0;
+
+    for (uint16_t slot = 0; slot < PAGES; slot++)
+    {
+        if (LoadPage(slot, tail))
+        {
+            uint16_t slot_sequence = static_cast<uint16_t>(tail[0] | (tail[1] << 8));
+
+            if (!found || static_cast<int16_t>(slot_sequence - newest_sequence) > 0)
+            {
+                found = true;
+                newest_slot = slot;
+                newest_sequence = slot_sequence;
+            }
+        }
+    }
+
+    stored_pages = 0;
+    tail_dirty = false;
+
+    if (!found)
+    {
+        tail_slot = 0;
+        sequence = 0;
+        tail_used = 0;
+        memset(tail, EMPTY, sizeof(tail));
+        tail[2] = 0;
+        return;
+    }
+
+    // Older pages directly precede the newest one with consecutive sequence numbers, a corrupted page among
+    // them is kept so the reader can skip it and resynchronise after it
+    for (uint16_t back = 1; back < PAGES; back++)
+    {
+        uint8_t header[2];
+
+        eeprom.ReadBlock(header, PageAddress((newest_slot + PAGES - back) % PAGES), sizeof(header));
+
+        if (static_cast<uint16_t>(header[0] | (header[1] << 8)) != static_cast<uint16_t>(newest_sequence - back))
+        {
+            break;
+        }
+
+        stored_pages++;
+    }
+
+    tail_slot = newest_slot;
+    sequence = newest_sequence;
+    LoadPage(tail_slot, tail);
+
+    // Walk the records of the newest page to find where the next one goes
+    uint8_t *payload = tail + HEADER_SIZE;
+    uint16_t position = tail[2];
+
+    while (position < PAYLOAD_SIZE && payload[position] != EMPTY)
+    {
+        position += 1 + payload[position];
+    }
+
+    if (position < PAYLOAD_SIZE)
+    {
+        tail_used = static_cast<uint8_t>(position);
+    }
+    else
+    {
+        // Full, or its last record continued on a page that never got written: start the next page
+        tail_used = PAYLOAD_SIZE;
+        Advance();
+    }
+}
+
+/**
+ * @brief Appends a record. Pages filled by the record are written, the rest stays in RAM until the tail
+ * page fills up or Flush() is called.
+ * @param data Pointer to the record.
+ * @param data_size The size of the record, at most 254 bytes.
+ * @return true if the record was appended, false if it is too long.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+bool EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Append(const void *data_ptr, uint8_t data_size)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    if (data_size == EMPTY)
+    {
+        return false;
+    }
+
+    uint16_t total = 1 + data_size; // Length byte and data
+
+    for (uint16_t i = 0; i < total; i++)
+    {
+        if (tail_used == 0 && i > 0)
+        {
+            tail[2] = static_cast<uint8_t>(total - i < PAYLOAD_SIZE ? total - i : PAYLOAD_SIZE);
+        }
+
+        Put(i == 0 ? data_size : data[i - 1]);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes the partly filled tail page. Costs a write cycle each time it is called with new records.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+void EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Flush()
+{
+    if (!tail_dirty)
+    {
+        return;
+    }
+
+    tail[0] = static_cast<uint8_t>(sequence);
+    tail[1] = static_cast<uint8_t>(sequence >> 8);
+    tail[3] = PageCheck(tail);
+    eeprom.WritePage(tail, PageAddress(tail_slot), PAGE_SIZE);
+    tail_dirty = false;
+}
+
+/**
+ * @brief Reads all records, oldest first, the ones still in RAM included.
+ * @param callback Called as bool(const uint8_t *data, uint8_t size) for every record, returns false to stop.
+ * Records longer than MAX_RECORD_SIZE are skipped.
+ * @return The number of records passed to the callback.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+template <typename Callback>
+uint16_t EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Read(Callback callback)
+{
+    uint8_t record[MAX_RECORD_SIZE];
+    uint8_t page[PAGE_SIZE];
+    uint16_t records = 0;
+    uint8_t length = 0;  // Length of the record being assembled
+    uint8_t missing = 0; // Bytes of it still to come
+    bool assembling = false;
+
+    for (uint16_t index = 0; index <= stored_pages; index++)
+    {
+        uint16_t slot = (tail_slot + PAGES - stored_pages + index) % PAGES;
+
+        if (slot == tail_slot)
+        {
+            memcpy(page, tail, PAGE_SIZE);
+        }
+        else if (!LoadPage(slot, page))
+        {
+            assembling = false; // The record crossing a bad page is lost
+            continue;
+        }
+
+        const uint8_t *payload = page + HEADER_SIZE;
+        uint8_t continuation = page[2];
+        uint16_t position = continuation;
+
+        if (assembling)
+        {
+            // The continuation must carry exactly the missing bytes, or the page is from another lap
+            uint8_t expected = missing < PAYLOAD_SIZE ? missing : PAYLOAD_SIZE;
+
+            if (continuation == expected)
+            {
+                if (length <= MAX_RECORD_SIZE)
+                {
+                    memcpy(record + length - missing, payload, continuation);
+                }
+
+                missing -= continuation;
+            }
+            else
+            {
+                assembling = false;
+            }
+        }
+
+        while (true)
+        {
+            if (assembling && missing == 0)
+            {
+                assembling = false;
+
+                if (length <= MAX_RECORD_SIZE)
+                {
+                    records++;
+
+                    if (!callback(static_cast<const uint8_t *>(record), length))
+                    {
+                        return records;
+                    }
+                }
+            }
+
+            if (assembling || position >= PAYLOAD_SIZE || payload[position] == EMPTY)
+            {
+                break;
+            }
+
+            length = payload[position++];
+            missing = length;
+            assembling = true;
+
+            uint8_t chunk = static_cast<uint8_t>(missing < PAYLOAD_SIZE - position ? missing : PAYLOAD_SIZE - position);
+
+            if (length <= MAX_RECORD_SIZE)
+            {
+                memcpy(record, payload + position, chunk);
+            }
+
+            missing -= chunk;
+            position += chunk;
+        }
+    }
+
+    return records;
+}
+
+/**
+ * @brief CRC-16 of sequence, continuation and payload, folded to one byte.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+uint8_t EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::PageCheck(const uint8_t *page)
+{
+    uint16_t crc = EepromCrc16(page, 3);
+
+    crc = EepromCrc16(page + HEADER_SIZE, PAYLOAD_SIZE, crc);
+
+    return static_cast<uint8_t>(crc ^ (crc >> 8));
+}
+
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+bool EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::LoadPage(uint16_t slot, uint8_t *page)
+{
+    eeprom.ReadBlock(page, PageAddress(slot), PAGE_SIZE);
+
+    return page[2] <= PAYLOAD_SIZE && page[3] == PageCheck(page);
+}
+
+/**
+ * @brief Adds one byte to the tail page, writing the page and moving on when it is full.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+void EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Put(uint8_t value)
+{
+    tail[HEADER_SIZE + tail_used++] = value;
+    tail_dirty = true;
+
+    if (tail_used == PAYLOAD_SIZE)
+    {
+        Flush();
+        Advance();
+    }
+}
+
+/**
+ * @brief Opens the next page of the ring, overwriting the oldest page when the ring is full.
+ */
+template <EepromM24CModel model, uint16_t PAGES, uint8_t MAX_RECORD_SIZE>
+void EepromM24CLog<model, PAGES, MAX_RECORD_SIZE>::Advance()
+{
+    tail_slot = (tail_slot + 1) % PAGES;
+    sequence++;
+    stored_pages = stored_pages < PAGES - 1 ? stored_pages + 1 : PAGES - 1;
+    tail_used = 0;
+    memset(tail, EMPTY, sizeof(tail));
+    tail[2] = 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Partition epoch for logical erase
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Eeprom M24C Partition ==========================================
+
+/**
+ * @brief Epoch header of a structured partition.
+ *
+ * Record layers stamp every record with the partition epoch and treat records of another epoch as free.
+ * FactoryReset bumps the epoch, which invalidates every record of the partition with a single page write
+ * instead of a ChipErase. Stale records are not erased: an EEPROM byte needs no erase before a write, so a
+ * stale record is simply overwritten when its location gets reused.
+ *
+ * The header holds two slots in one page, written alternately, so a reset interrupted by a power loss
+ * leaves the previous epoch intact.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ */
+template <EepromM24CModel model>
+class EepromM24CPartition
+{
+public:
+    static constexpr uint8_t SLOT_SIZE = 8; /**< Size of one header slot */
+
+    static_assert(EepromM24C<model>::PAGE_SIZE >= 2 * SLOT_SIZE, "Partition header slots must share one page");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param header_address Start address of the header. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CPartition(EepromM24C<model> &eeprom_instance, uint16_t header_address)
+        : eeprom(eeprom_instance), address(header_address) {}
+
+    void Mount();
+    void FactoryReset();
+
+    /**
+     * @brief Current epoch. Records stamped with another epoch are free.
+     */
+    uint16_t Epoch() const { return epoch; }
+
+    /**
+     * @brief Checks whether a record stamped with the given epoch belongs to the current partition contents.
+     */
+    bool IsCurrent(uint16_t record_epoch) const { return record_epoch == epoch; }
+
+private:
+    static constexpr uint8_t HEADER_MAGIC = 0xE7;
+
+    bool ReadSlot(uint8_t slot, uint16_t &slot_epoch);
+    void WriteSlot(uint8_t slot);
+
+    EepromM24C<model> &eeprom;
+    uint16_t address;
+    uint16_t epoch = 0;
+    uint8_t next_slot = 0;
+};
+
+// ========================================= Eeprom M24C Partition Implementation ==========================================
+
+/**
+ * @brief Loads the epoch. An unformatted header is initialized with epoch 0.
+ */
+template <EepromM24CModel model>
+void EepromM24CPartition<model>::Mount()
+{
+    uint16_t epoch_a = 0;
+    uint16_t epoch_b = 0;
+    bool valid_a = ReadSlot(0, epoch_a);
+    bool valid_b = ReadSlot(1, epoch_b);
+
+    if (!valid_a && !valid_b)
+    {
+        epoch = 0;
+        WriteSlot(0);
+        return;
+    }
+
+    if (valid_a && (!valid_b || static_cast<int16_t>(epoch_a - epoch_b) > 0))
+    {
+        epoch = epoch_a;
+        next_slot = 1;
+    }
+    else
+    {
+        epoch = epoch_b;
+        next_slot = 0;
+    }
+}
+
+/**
+ * @brief Logically erases the partition: all records written so far become free. One page write.
+ */
+template <EepromM24CModel model>
+void EepromM24CPartition<model>::FactoryReset()
+{
+    epoch++;
+    WriteSlot(next_slot);
+}
+
+/**
+ * @brief Reads a header slot: [magic][epoch LE16][crc LE16].
+ * @return true if the slot is valid.
+ */
+template <EepromM24CModel model>
+bool EepromM24CPartition<model>::ReadSlot(uint8_t slot, uint16_t &slot_epoch)
+{
+    uint8_t header[5];
+
+    eeprom.ReadBlock(header, address + slot * SLOT_SIZE, sizeof(header));
+
+    if (header[0] != HEADER_MAGIC || EepromCrc16(header, 3) != static_cast<uint16_t>(header[3] | (header[4] << 8)))
+    {
+        return false;
+    }
+
+    slot_epoch = static_cast<uint16_t>(header[1] | (header[2] << 8));
+
+    return true;
+}
+
+template <EepromM24CModel model>
+void EepromM24CPartition<model>::WriteSlot(uint8_t slot)
+{
+    uint8_t header[5];
+
+    header[0] = HEADER_MAGIC;
+    header[1] = static_cast<uint8_t>(epoch);
+    header[2] = static_cast<uint8_t>(epoch >> 8);
+
+    uint16_t crc = EepromCrc16(header, 3);
+
+    header[3] = static_cast<uint8_t>(crc);
+    header[4] = static_cast<uint8_t>(crc >> 8);
+
+    eeprom.WritePage(header, address + slot * SLOT_SIZE, sizeof(header));
+    next_slot = slot ^ 1;
+}
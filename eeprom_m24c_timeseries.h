@@ -0,0 +1,617 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Compressed time-series log
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Bit Stream ==========================================
+
+/**
+ * @brief MSB-first bit writer over a byte buffer. The buffer must be zeroed.
+ */
+class EepromM24CBitWriter
+{
+public:
+    EepromM24CBitWriter(uint8_t *buffer_ptr, uint16_t bit_position = 0) : buffer(buffer_ptr), position(bit_position) {}
+
+    void Write(uint64_t value, uint8_t bits)
+    {
+        while (bits-- > 0)
+        {
+            if ((value >> bits) & 1)
+            {
+                buffer[position / 8] |= static_cast<uint8_t>(0x80 >> (position % 8));
+            }
+
+            position++;
+        }
+    }
+
+    /**
+     * @brief Zig-zag varint in 7-bit groups, each group preceded by a continuation bit.
+     */
+    void WriteVarint(int64_t value)
+    {
+        uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+
+        do
+        {
+            uint8_t group = zigzag & 0x7F;
+
+            zigzag >>= 7;
+            Write(zigzag != 0 ? 1 : 0, 1);
+            Write(group, 7);
+        } while (zigzag != 0);
+    }
+
+    uint16_t Position() const { return position; }
+
+private:
+    uint8_t *buffer;
+    uint16_t position;
+};
+
+/**
+ * @brief MSB-first bit reader, stops at the end of the buffer.
+ */
+class EepromM24CBitReader
+{
+public:
+    EepromM24CBitReader(const uint8_t *buffer_ptr, uint16_t bit_length) : buffer(buffer_ptr), length(bit_length) {}
+
+    uint64_t Read(uint8_t bits)
+    {
+        uint64_t value = 0;
+
+        while (bits-- > 0)
+        {
+            value <<= 1;
+
+            if (position < length)
+            {
+                value |= (buffer[position / 8] >> (7 - position % 8)) & 1;
+            }
+
+            position++;
+        }
+
+        return value;
+    }
+
+    int64_t ReadVarint()
+    {
+        uint64_t zigzag = 0;
+        uint8_t shift = 0;
+        bool more = true;
+
+        while (more && shift < 64)
+        {
+            more = Read(1) != 0;
+            zigzag |= Read(7) << shift;
+            shift += 7;
+        }
+
+        return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    }
+
+    bool IsOverrun() const { return position > length; }
+    uint16_t Position() const { return position; }
+
+private:
+    const uint8_t *buffer;
+    uint16_t length;
+    uint16_t position = 0;
+};
+
+// ========================================= Value Codecs ==========================================
+
+/**
+ * @brief Value encoding of a time series, specialized per sample type.
+ */
+template <typename Value>
+struct EepromM24CSeriesCodec;
+
+/**
+ * @brief Integer samples: '0' if unchanged, '1' + zig-zag varint of the delta otherwise.
+ */
+template <>
+struct EepromM24CSeriesCodec<int32_t>
+{
+    static constexpr uint8_t MAX_BITS = 1 + 5 * 8;
+
+    static void Encode(EepromM24CBitWriter &writer, int32_t previous, int32_t value)
+    {
+        int64_t delta = static_cast<int64_t>(value) - previous;
+
+        writer.Write(delta != 0 ? 1 : 0, 1);
+
+        if (delta != 0)
+        {
+            writer.WriteVarint(delta);
+        }
+    }
+
+    static int32_t Decode(EepromM24CBitReader &reader, int32_t previous)
+    {
+        return reader.Read(1) != 0 ? static_cast<int32_t>(previous + reader.ReadVarint()) : previous;
+    }
+};
+
+/**
+ * @brief Float samples: XOR with the previous value, byte granular. '0' if unchanged, otherwise '1',
+ * 2 bits of leading zero bytes, 2 bits of meaningful bytes - 1, then the meaningful bytes.
+ */
+template <>
+struct EepromM24CSeriesCodec<float>
+{
+    static constexpr uint8_t MAX_BITS = 1 + 4 + 32;
+
+    static void Encode(EepromM24CBitWriter &writer, float previous, float value)
+    {
+        uint32_t bits = Bits(previous) ^ Bits(value);
+
+        writer.Write(bits != 0 ? 1 : 0, 1);
+
+        if (bits != 0)
+        {
+            uint8_t leading = 0;
+            uint8_t trailing = 0;
+
+            while ((bits >> (24 - 8 * leading)) == 0)
+            {
+                leading++;
+            }
+
+            while (((bits >> (8 * trailing)) & 0xFF) == 0)
+            {
+                trailing++;
+            }
+
+            uint8_t meaningful = static_cast<uint8_t>(4 - leading - trailing);
+
+            writer.Write(leading, 2);
+            writer.Write(meaningful - 1, 2);
+            writer.Write(bits >> (8 * trailing), 8 * meaningful);
+        }
+    }
+
+    static float Decode(EepromM24CBitReader &reader, float previous)
+    {
+        uint32_t bits = Bits(previous);
+
+        if (reader.Read(1) != 0)
+        {
+            uint8_t leading = static_cast<uint8_t>(reader.Read(2));
+            uint8_t meaningful = static_cast<uint8_t>(reader.Read(2) + 1);
+            uint8_t trailing = static_cast<uint8_t>(leading + meaningful <= 4 ? 4 - leading - meaningful : 0);
+
+            bits ^= static_cast<uint32_t>(reader.Read(8 * meaningful) << (8 * trailing));
+        }
+
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    static uint32_t Bits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+};
+
+// ========================================= Eeprom M24C Time Series ==========================================
+
+/**
+ * @brief Ring of compressed frames holding (timestamp, value) samples.
+ *
+ * Samples are compressed into a frame of FRAME_PAGES pages in RAM. Timestamps are stored as
+ * delta-of-delta ('0' for a regular interval, '1' + zig-zag varint otherwise), values with the codec of
+ * the sample type. Slowly changing samples at a fixed rate take a few bits each, against 8 bytes raw.
+ *
+ * A frame is written with one WritePage per page when it is full or on Flush, so the write cycles per
+ * sample drop by the compression ratio. Frames are independent and start with a raw sample, any frame is
+ * decoded without the others. FindFrame locates the frame of a timestamp by binary search over the frame
+ * headers.
+ *
+ * Frame layout: [magic][sequence LE16][count][complete stream bytes][first timestamp LE32][first value]
+ * [crc LE16] then the bit stream. The CRC covers the header and the complete stream bytes, the partial last
+ * byte is left out: a later Flush only adds bits to it, so a Flush torn by a power loss leaves the previous
+ * header valid. Mount resumes the newest frame; samples appended after the last Flush are lost.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam Value Sample type, int32_t or float.
+ * @tparam FRAMES Number of frames in the ring.
+ * @tparam FRAME_PAGES Pages per frame.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES = 4>
+class EepromM24CTimeSeries
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                      /**< Page size in bytes for the specified model */
+    static constexpr uint16_t FRAME_SIZE = static_cast<uint16_t>(FRAME_PAGES) * PAGE_SIZE; /**< Frame size in bytes */
+    static constexpr uint8_t HEADER_SIZE = 15;                                              /**< Frame header size */
+    static constexpr uint16_t STREAM_BITS = (FRAME_SIZE - HEADER_SIZE) * 8;                 /**< Bit stream capacity of a frame */
+
+    static_assert(sizeof(Value) == 4, "Samples are 32-bit values");
+    static_assert(FRAME_SIZE > HEADER_SIZE && FRAME_SIZE - HEADER_SIZE <= 0xFF, "Stream length is stored in one byte");
+    static_assert(FRAMES >= 2, "The ring needs at least two frames");
+    static_assert(static_cast<uint32_t>(FRAMES) * FRAME_SIZE <= EepromM24C<model>::MEMORY_SIZE, "Time series exceeds the memory size");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param base_address Start address of the ring. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CTimeSeries(EepromM24C<model> &eeprom_instance, uint16_t base_address)
+        : eeprom(eeprom_instance), base(base_address) {}
+
+    void Mount();
+    void Append(uint32_t timestamp, Value value);
+    void Flush();
+
+    /**
+     * @brief Number of readable frames, the open frame included. Frame 0 is the oldest.
+     */
+    uint16_t FrameCount() const { return stored_frames + (count > 0 ? 1 : 0); }
+
+    uint16_t FindFrame(uint32_t timestamp);
+
+    template <typename Callback>
+    bool ReadFrame(uint16_t index, Callback callback);
+
+private:
+    static constexpr uint8_t FRAME_MAGIC = 0x75;
+
+    uint16_t FrameAddress(uint16_t slot) const { return base + slot * FRAME_SIZE; }
+    uint16_t SlotOf(uint16_t index) const { return (current_slot + FRAMES - stored_frames + index) % FRAMES; }
+
+    static uint16_t FrameCrc(const uint8_t *frame);
+    bool LoadFrame(uint16_t slot, uint8_t *frame);
+    void Seal();
+
+    template <typename Callback>
+    static void Decode(const uint8_t *frame, Callback callback, uint32_t *last_timestamp, int64_t *last_delta, Value *last_value, uint16_t *bits);
+
+    EepromM24C<model> &eeprom;
+    uint16_t base;
+    uint16_t current_slot = 0;    // Slot of the open frame
+    uint16_t sequence = 0;        // Sequence of the open frame
+    uint16_t stored_frames = 0;   // Complete frames before the open one
+    uint8_t count = 0;            // Samples in the open frame
+    uint16_t stream_bits = 0;     // Used bits of the open frame
+    uint16_t flushed_bits = 0;    // Stream bits already in the EEPROM
+    uint32_t last_timestamp = 0;
+    int64_t last_delta = 0;
+    Value last_value = 0;
+    uint8_t frame[FRAME_SIZE];
+};
+
+// ========================================= Eeprom M24C Time Series Implementation ==========================================
+
+/**
+ * @brief Finds the newest frame and resumes it. Call it once before any other method.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+void EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::Mount()
+{
+    bool found = false;
+    uint16_t newest_slot = 0;
+    uint16_t newest_sequence = 0;
+    uint8_t header[3];
+
+    for (uint16_t slot = 0; slot < FRAMES; slot++)
+    {
+        eeprom.ReadBlock(header, FrameAddress(slot), sizeof(header));
+
+        uint16_t slot_sequence = static_cast<uint16_t>(header[1] | (header[2] << 8));
+
+        if (header[0] == FRAME_MAGIC && (!found || static_cast<int16_t>(slot_sequence - newest_sequence) > 0) && LoadFrame(slot, frame))
+        {
+            found = true;
+            newest_slot = slot;
+            newest_sequence = slot_sequence;
+        }
+    }
+
+    memset(frame, 0, sizeof(frame));
+    count = 0;
+    stream_bits = 0;
+    flushed_bits = 0;
+    stored_frames = 0;
+
+    if (!found)
+    {
+        current_slot = 0;
+        sequence = 0;
+        return;
+    }
+
+    // Older frames directly precede the newest one in the ring, with consecutive sequence numbers
+    for (uint16_t back = 1; back < FRAMES; back++)
+    {
+        eeprom.ReadBlock(header, FrameAddress((newest_slot + FRAMES - back) % FRAMES), sizeof(header));
+
+        if (header[0] != FRAME_MAGIC || static_cast<uint16_t>(header[1] | (header[2] << 8)) != static_cast<uint16_t>(newest_sequence - back))
+        {
+            break;
+        }
+
+        stored_frames++;
+    }
+
+    current_slot = newest_slot;
+    sequence = newest_sequence;
+    LoadFrame(current_slot, frame);
+    count = frame[3];
+    Decode(frame, [](uint32_t, Value) {}, &last_timestamp, &last_delta, &last_value, &stream_bits);
+    flushed_bits = stream_bits;
+
+    // Bits past the last sample may come from a torn Flush, new samples are ORed into the stream
+    uint8_t *stream = frame + HEADER_SIZE;
+
+    if (stream_bits % 8 != 0)
+    {
+        stream[stream_bits / 8] &= static_cast<uint8_t>(0xFF00 >> (stream_bits % 8));
+    }
+
+    memset(stream + (stream_bits + 7) / 8, 0, FRAME_SIZE - HEADER_SIZE - (stream_bits + 7) / 8);
+}
+
+/**
+ * @brief Appends a sample. Writes the open frame to the EEPROM when it is full.
+ * @param timestamp Sample time, non-decreasing.
+ * @param value Sample value.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+void EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::Append(uint32_t timestamp, Value value)
+{
+    if (count > 0)
+    {
+        uint8_t scratch[(EepromM24CSeriesCodec<Value>::MAX_BITS + 41 + 7) / 8] = {};
+        EepromM24CBitWriter encoder(scratch);
+        int64_t delta = static_cast<int64_t>(timestamp) - last_timestamp;
+        int64_t delta_of_delta = delta - last_delta;
+
+        encoder.Write(delta_of_delta != 0 ? 1 : 0, 1);
+
+        if (delta_of_delta != 0)
+        {
+            encoder.WriteVarint(delta_of_delta);
+        }
+
+        EepromM24CSeriesCodec<Value>::Encode(encoder, last_value, value);
+
+        if (stream_bits + encoder.Position() <= STREAM_BITS && count < 0xFF)
+        {
+            EepromM24CBitReader bits(scratch, encoder.Position());
+            EepromM24CBitWriter writer(frame + HEADER_SIZE, stream_bits);
+
+            for (uint16_t i = 0; i < encoder.Position(); i++)
+            {
+                writer.Write(bits.Read(1), 1);
+            }
+
+            stream_bits = writer.Position();
+            count++;
+            last_delta = delta;
+            last_timestamp = timestamp;
+            last_value = value;
+            return;
+        }
+
+        Seal();
+    }
+
+    // The first sample of a frame is stored raw in the header
+    frame[0] = FRAME_MAGIC;
+    frame[1] = static_cast<uint8_t>(sequence);
+    frame[2] = static_cast<uint8_t>(sequence >> 8);
+    memcpy(frame + 5, &timestamp, 4);
+    memcpy(frame + 9, &value, 4);
+    count = 1;
+    last_delta = 0;
+    last_timestamp = timestamp;
+    last_value = value;
+}
+
+/**
+ * @brief Writes the samples of the open frame that are not in the EEPROM yet.
+ * Only the header page and the pages with new stream bytes are written.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+void EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::Flush()
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    uint16_t used = HEADER_SIZE + (stream_bits + 7) / 8;
+
+    frame[3] = count;
+    frame[4] = static_cast<uint8_t>(stream_bits / 8);
+
+    uint16_t crc = FrameCrc(frame);
+
+    frame[13] = static_cast<uint8_t>(crc);
+    frame[14] = static_cast<uint8_t>(crc >> 8);
+
+    // The header page goes last, a torn flush leaves the previous header describing unchanged bytes
+    uint16_t first_dirty = HEADER_SIZE + flushed_bits / 8;
+
+    for (uint16_t offset = first_dirty - (first_dirty % PAGE_SIZE); offset < used; offset += PAGE_SIZE)
+    {
+        if (offset >= PAGE_SIZE)
+        {
+            uint8_t chunk = static_cast<uint8_t>(used - offset < PAGE_SIZE ? used - offset : PAGE_SIZE);
+
+            eeprom.WritePage(frame + offset, FrameAddress(current_slot) + offset, chunk);
+        }
+    }
+
+    eeprom.WritePage(frame, FrameAddress(current_slot), static_cast<uint8_t>(used < PAGE_SIZE ? used : PAGE_SIZE));
+    flushed_bits = stream_bits;
+}
+
+/**
+ * @brief Index of the frame holding the timestamp: the newest frame starting at or before it, 0 if every
+ * frame starts later. Reads one header per step of a binary search.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+uint16_t EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::FindFrame(uint32_t timestamp)
+{
+    uint16_t low = 0;
+    uint16_t high = FrameCount();
+
+    while (high - low > 1)
+    {
+        uint16_t middle = (low + high) / 2;
+        uint32_t first_timestamp;
+
+        if (middle == stored_frames)
+        {
+            memcpy(&first_timestamp, frame + 5, 4);
+        }
+        else
+        {
+            eeprom.ReadBlock(&first_timestamp, FrameAddress(SlotOf(middle)) + 5, 4);
+        }
+
+        if (first_timestamp <= timestamp)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Decodes one frame.
+ * @param index Frame index, 0 is the oldest.
+ * @param callback Called as callback(timestamp, value) for every sample of the frame, oldest first.
+ * @return false if the index is out of range or the frame is corrupted.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+template <typename Callback>
+bool EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::ReadFrame(uint16_t index, Callback callback)
+{
+    if (index >= FrameCount())
+    {
+        return false;
+    }
+
+    if (index == stored_frames)
+    {
+        frame[3] = count;
+        frame[4] = static_cast<uint8_t>(stream_bits / 8);
+        Decode(frame, callback, nullptr, nullptr, nullptr, nullptr);
+        return true;
+    }
+
+    uint8_t stored[FRAME_SIZE];
+
+    if (!LoadFrame(SlotOf(index), stored))
+    {
+        return false;
+    }
+
+    Decode(stored, callback, nullptr, nullptr, nullptr, nullptr);
+
+    return true;
+}
+
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+uint16_t EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::FrameCrc(const uint8_t *frame_ptr)
+{
+    uint16_t crc = EepromCrc16(frame_ptr, 13);
+
+    return EepromCrc16(frame_ptr + HEADER_SIZE, frame_ptr[4], crc);
+}
+
+/**
+ * @brief Reads a frame and checks its CRC.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+bool EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::LoadFrame(uint16_t slot, uint8_t *frame_ptr)
+{
+    eeprom.ReadBlock(frame_ptr, FrameAddress(slot), FRAME_SIZE);
+
+    return frame_ptr[0] == FRAME_MAGIC && frame_ptr[3] != 0 && frame_ptr[4] <= FRAME_SIZE - HEADER_SIZE &&
+           FrameCrc(frame_ptr) == static_cast<uint16_t>(frame_ptr[13] | (frame_ptr[14] << 8));
+}
+
+/**
+ * @brief Writes the full frame and opens the next one in the ring.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+void EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::Seal()
+{
+    Flush();
+
+    current_slot = (current_slot + 1) % FRAMES;
+    sequence++;
+    stored_frames = stored_frames < FRAMES - 1 ? stored_frames + 1 : FRAMES - 1;
+    count = 0;
+    stream_bits = 0;
+    flushed_bits = 0;
+    memset(frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Decodes a frame, optionally returning the codec state after the last sample.
+ */
+template <EepromM24CModel model, typename Value, uint16_t FRAMES, uint8_t FRAME_PAGES>
+template <typename Callback>
+void EepromM24CTimeSeries<model, Value, FRAMES, FRAME_PAGES>::Decode(const uint8_t *frame_ptr, Callback callback, uint32_t *last_timestamp_out,
+                                                                     int64_t *last_delta_out, Value *last_value_out, uint16_t *bits_out)
+{
+    // The partial byte after the complete ones holds the tail of the last sample
+    uint16_t stream_bytes = frame_ptr[4] < FRAME_SIZE - HEADER_SIZE ? frame_ptr[4] + 1 : frame_ptr[4];
+    EepromM24CBitReader reader(frame_ptr + HEADER_SIZE, stream_bytes * 8);
+    uint32_t timestamp;
+    Value value;
+    int64_t delta = 0;
+
+    memcpy(&timestamp, frame_ptr + 5, 4);
+    memcpy(&value, frame_ptr + 9, 4);
+    callback(timestamp, value);
+
+    for (uint8_t i = 1; i < frame_ptr[3] && !reader.IsOverrun(); i++)
+    {
+        if (reader.Read(1) != 0)
+        {
+            delta += reader.ReadVarint();
+        }
+
+        timestamp = static_cast<uint32_t>(timestamp + delta);
+        value = EepromM24CSeriesCodec<Value>::Decode(reader, value);
+        callback(timestamp, value);
+    }
+
+    if (last_timestamp_out != nullptr)
+    {
+        *last_timestamp_out = timestamp;
+        *last_delta_out = delta;
+        *last_value_out = value;
+        *bits_out = reader.Position();
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Worst-case timing bounds
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "eeprom_m24c.h"
+
+// ========================================= Eeprom M24C Timing ==========================================
+
+/**
+ * @brief Bus and retry configuration the bounds are computed for.
+ */
+struct EepromM24CTimingConfig
+{
+    uint32_t bus_hz;           /**< I2C clock, the slowest step with an EepromM24CBusSpeedPolicy */
+    uint16_t max_attempts;     /**< Attempts per transaction as passed to EepromM24C, must not be 0 */
+    bool full_failed_attempts; /**< A failed attempt costs a whole transaction instead of a NACKed device select */
+    bool time_source;          /**< The platform implements I2C_M24C::GetTimeUs, the driver waits out tW before polling */
+};
+
+/**
+ * @brief Compile-time worst-case duration of the EepromM24C calls, in nanoseconds of bus time.
+ *
+ * A transaction costs 9 clocks per byte, device select codes included, and 2 clocks per START (START and
+ * STOP or repeated START). With max_attempts = A a transaction takes at most A - 1 failed attempts and one
+ * successful attempt; a call that runs out of attempts ends earlier. A failed attempt is a device select
+ * NACKed while the chip is busy with a write cycle, the rest of the attempt is skipped by the I2C layer;
+ * set full_failed_attempts when the platform may fail late in a transaction (bus faults).
+ *
+ * Write calls return while the chip is still programming the last page, *ReadyNs adds the write cycle
+ * time tW. CPU time between bus operations and I2C_M24C::Init() are not included. With time_source every
+ * transaction may first wait for the predicted end of the previous write cycle, up to tW plus the clock
+ * resolution, and then still takes its attempts when the prediction was early.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ */
+template <EepromM24CModel model>
+class EepromM24CTiming
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                          /**< Page size in bytes for the specified model */
+    static constexpr uint16_t MEMORY_SIZE = EepromM24C<model>::MEMORY_SIZE;                     /**< Total memory size in bytes for the specified model */
+    static constexpr uint64_t WRITE_CYCLE_NS = EepromM24C<model>::WRITE_CYCLE_TIME_US * 1000ULL; /**< Maximum write cycle time tW */
+    static constexpr uint64_t CLOCK_TICK_NS = 1000ULL;                                           /**< Resolution of I2C_M24C::GetTimeUs */
+
+    /**
+     * @brief Duration of one bus clock, rounded up.
+     */
+    static constexpr uint64_t ClockNs(const EepromM24CTimingConfig &config) { return (1000000000ULL + config.bus_hz - 1) / config.bus_hz; }
+
+    /**
+     * @brief One successful transaction of the given bytes on the bus with the given number of STARTs.
+     */
+    static constexpr uint64_t TransferNs(const EepromM24CTimingConfig &config, uint32_t bytes, uint8_t starts)
+    {
+        return (bytes * 9ULL + starts * 2ULL) * ClockNs(config);
+    }
+
+    /**
+     * @brief Wait for the predicted end of the previous write cycle before a transaction, 0 without time_source.
+     * The prediction is at most tW after the time stamp taken at the end of the write; the wait ends on the
+     * first clock reading at or after it and the reading that times the first attempt may fall in the next tick.
+     */
+    static constexpr uint64_t LazyWaitNs(const EepromM24CTimingConfig &config) { return config.time_source ? WRITE_CYCLE_NS + 2 * CLOCK_TICK_NS : 0; }
+
+    /**
+     * @brief A transaction including the lazy wait and all failed attempts the retry policy allows.
+     */
+    static constexpr uint64_t TransactionNs(const EepromM24CTimingConfig &config, uint32_t bytes, uint8_t starts)
+    {
+        uint64_t success = TransferNs(config, bytes, starts);
+        uint64_t failure = config.full_failed_attempts ? success : TransferNs(config, 1, 1);
+
+        return LazyWaitNs(config) + (config.max_attempts - 1ULL) * failure + success;
+    }
+
+    /**
+     * @brief Attempts needed to outlast the write cycle of the previous write without running out:
+     * every attempt but the last may be NACKed while the chip programs.
+     */
+    static constexpr uint16_t MinAttempts(const EepromM24CTimingConfig &config)
+    {
+        uint64_t failure = TransferNs(config, 1, 1);
+
+        return static_cast<uint16_t>((WRITE_CYCLE_NS + failure - 1) / failure + 1);
+    }
+
+    /**
+     * @brief ReadBlock (both forms), and ReadByte/ReadHalfWord/ReadScalar with size 1, 2, 4 or 8: select, address, select, data.
+     */
+    static constexpr uint64_t ReadNs(const EepromM24CTimingConfig &config, uint16_t size) { return TransactionNs(config, 3U + size, 2); }
+
+    /**
+     * @brief WritePage, and WriteByte/WriteHalfWord with size 1 or 2: select, address, data.
+     */
+    static constexpr uint64_t WritePageNs(const EepromM24CTimingConfig &config, uint8_t size) { return TransactionNs(config, 2U + size, 1); }
+
+    /**
+     * @brief WriteBlock: one transaction per full page and one for the remainder, if any.
+     * The single-page WriteBlock<ADDRESS, SIZE> is WritePageNs(config, SIZE).
+     */
+    static constexpr uint64_t WriteBlockNs(const EepromM24CTimingConfig &config, uint16_t size)
+    {
+        return (size / PAGE_SIZE) * WritePageNs(config, PAGE_SIZE) + (size % PAGE_SIZE != 0 ? WritePageNs(config, static_cast<uint8_t>(size % PAGE_SIZE)) : 0);
+    }
+
+    static constexpr uint64_t ErasePageNs(const EepromM24CTimingConfig &config) { return WritePageNs(config, PAGE_SIZE); }
+
+    static constexpr uint64_t ChipEraseNs(const EepromM24CTimingConfig &config) { return (MEMORY_SIZE / PAGE_SIZE) * ErasePageNs(config); }
+
+    /**
+     * @brief Until the chip accepts the next transaction after a write call.
+     */
+    static constexpr uint64_t WriteBlockReadyNs(const EepromM24CTimingConfig &config, uint16_t size) { return WriteBlockNs(config, size) + WRITE_CYCLE_NS; }
+
+    static constexpr uint64_t ChipEraseReadyNs(const EepromM24CTimingConfig &config) { return ChipEraseNs(config) + WRITE_CYCLE_NS; }
+};
@@ -0,0 +1,431 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - TLV serialization
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-18
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+#include "eeprom_m24c_partition.h"
+
+// ========================================== TLV Schema ==========================================
+
+/**
+ * @brief Extracts the owning class and the member type from a pointer to data member.
+ */
+template <typename MemberPointer>
+struct TlvMemberTraits;
+
+template <typename C, typename M>
+struct TlvMemberTraits<M C::*>
+{
+    using Class = C;
+    using Member = M;
+};
+
+/**
+ * @brief Single schema field: binds a tag to a data member of the stored structure.
+ *
+ * Encoded as [tag][length][value bytes]. Values are stored in the byte order of the host, so records are
+ * only portable between little-endian targets, and widening relies on the little-endian layout.
+ * When a stored value is shorter than the member (e.g. uint8_t widened to uint16_t in a newer schema)
+ * it is sign-extended for signed integer members and zero-extended otherwise; when it is longer it is
+ * truncated.
+ *
+ * @tparam TAG Unique field tag. Must never be reused for a different meaning.
+ * @tparam MEMBER Pointer to the data member, e.g. &Config::baudrate.
+ */
+template <uint8_t TAG, auto MEMBER>
+struct TlvField
+{
+    using Class = typename TlvMemberTraits<decltype(MEMBER)>::Class;
+    using Member = typename TlvMemberTraits<decltype(MEMBER)>::Member;
+
+    static_assert(std::is_trivially_copyable<Member>::value, "TLV fields must be trivially copyable");
+    static_assert(sizeof(Member) <= 0xFF, "TLV field value must fit in a single length byte");
+
+    static constexpr uint8_t FIELD_TAG = TAG;                /**< Tag of the field */
+    static constexpr uint8_t VALUE_SIZE = sizeof(Member);    /**< Size of the encoded value */
+    static constexpr uint16_t ENCODED_SIZE = 2 + VALUE_SIZE; /**< Tag + length + value */
+
+    /**
+     * @brief Appends the field to the output buffer.
+     * @param value The structure to take the member from.
+     * @param output Pointer to the output position.
+     * @return Pointer past the encoded field.
+     */
+    static uint8_t *Encode(const Class &value, uint8_t *output)
+    {
+        *output++ = TAG;
+        *output++ = VALUE_SIZE;
+        memcpy(output, &(value.*MEMBER), VALUE_SIZE);
+
+        return output + VALUE_SIZE;
+    }
+
+    /**
+     * @brief Decodes the field if the tag matches.
+     * @param tag Tag of the stored entry.
+     * @param input Pointer to the stored value bytes.
+     * @param length Length of the stored value.
+     * @param value The structure to store the member in.
+     * @return true if the entry belonged to this field, false otherwise.
+     */
+    static bool Decode(uint8_t tag, const uint8_t *input, uint8_t length, Class &value)
+    {
+        if (tag != TAG)
+        {
+            return false;
+        }
+
+        uint8_t *member = reinterpret_cast<uint8_t *>(&(value.*MEMBER));
+        bool negative = std::is_integral<Member>::value && std::is_signed<Member>::value && length > 0 && (input[length - 1] & 0x80) != 0;
+
+        memset(member, negative ? 0xFF : 0x00, VALUE_SIZE);
+        memcpy(member, input, length < VALUE_SIZE ? length : VALUE_SIZE);
+
+        return true;
+    }
+};
+
+/**
+ * @brief Compile-time schema: the codec is generated from the field list.
+ *
+ * Decoding is tag driven, so a record written by an older (or newer) schema version decodes into the
+ * current structure: unknown tags are skipped, missing fields keep the value they had before Decode
+ * (typically the defaults of the structure).
+ *
+ * @tparam T The stored structure.
+ * @tparam VERSION Schema version. Bump it when fields are added, removed or change type.
+ * @tparam FIELDS The TlvField list.
+ */
+template <typename T, uint8_t VERSION, typename... FIELDS>
+struct TlvSchema
+{
+    using Type = T;
+
+    static_assert(sizeof...(FIELDS) > 0, "TLV schema needs at least one field");
+    static_assert((std::is_same<typename FIELDS::Class, T>::value && ...), "TLV fields must belong to the schema type");
+
+    static constexpr uint8_t SCHEMA_VERSION = VERSION;                              /**< Version written with every record */
+    static constexpr uint16_t MAX_ENCODED_SIZE = (0 + ... + FIELDS::ENCODED_SIZE); /**< Encoded size of all fields */
+
+    /**
+     * @brief Checks that no tag is used twice.
+     */
+    static constexpr bool TagsUnique()
+    {
+        constexpr uint8_t tags[] = {FIELDS::FIELD_TAG...};
+
+        for (uint16_t i = 0; i < sizeof...(FIELDS); i++)
+        {
+            for (uint16_t j = i + 1; j < sizeof...(FIELDS); j++)
+            {
+                if (tags[i] == tags[j])
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(TagsUnique(), "TLV schema tags must be unique");
+
+    /**
+     * @brief Encodes all fields.
+     * @param value The structure to encode.
+     * @param output Buffer of at least MAX_ENCODED_SIZE bytes.
+     * @return Number of bytes written.
+     */
+    static uint16_t Encode(const T &value, uint8_t *output)
+    {
+        uint8_t *position = output;
+
+        ((position = FIELDS::Encode(value, position)), ...);
+
+        return static_cast<uint16_t>(position - output);
+    }
+
+    /**
+     * @brief Decodes a TLV stream into the structure.
+     * @param input Pointer to the encoded fields.
+     * @param size Size of the encoded fields.
+     * @param value The structure to decode into.
+     * @return false if the stream is malformed (truncated entry), true otherwise.
+     */
+    static bool Decode(const uint8_t *input, uint16_t size, T &value)
+    {
+        uint16_t position = 0;
+
+        while (position + 2 <= size)
+        {
+            uint8_t tag = input[position];
+            uint8_t length = input[position + 1];
+
+            position += 2;
+
+            if (position + length > size)
+            {
+                return false;
+            }
+
+            (FIELDS::Decode(tag, input + position, length, value) || ...);
+            position += length;
+        }
+
+        return position == size;
+    }
+};
+
+// ========================================== TLV Record ==========================================
+
+/**
+ * @brief Result of loading a TLV record.
+ */
+enum class TlvLoadResult
+{
+    Empty,    /**< Nothing stored yet (erased memory or stale partition epoch), value left untouched */
+    Corrupt,  /**< Stored record failed the integrity check, value left untouched */
+    Current,  /**< Record decoded, stored with the current schema version */
+    Migrated, /**< Record decoded from another schema version, converted on the next Store */
+};
+
+/**
+ * @brief Single versioned TLV record stored at a fixed EEPROM address.
+ *
+ * Layout of a slot: [magic][version][epoch LE16][length LE16][sequence][crc LE16][TLV fields...]
+ *
+ * The record alternates between two page-aligned slots. Store writes the slot that does not hold the
+ * newest valid record and Load takes the valid slot with the newer sequence, so a power loss during a
+ * Store leaves the previous record loadable.
+ *
+ * Schema migration is lazy: Load converts an old record in RAM only, the EEPROM is rewritten in the
+ * current format the first time the application calls Store. Nothing is rewritten at boot. The record of
+ * the old schema stays in its slot until a later Store overwrites it.
+ *
+ * When the record belongs to a partition, it is stamped with the partition epoch and a record of an older
+ * epoch loads as Empty, so a partition FactoryReset clears it without touching the record itself.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam Schema The TlvSchema of the record.
+ * @tparam CAPACITY Bytes reserved per slot. Reserve headroom if future schema versions can grow.
+ */
+template <EepromM24CModel model, typename Schema, uint16_t CAPACITY = 9 + Schema::MAX_ENCODED_SIZE>
+class EepromM24CTlvRecord
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                               /**< Page size in bytes for the specified model */
+    static constexpr uint8_t HEADER_SIZE = 9;                                                       /**< Size of the record header */
+    static constexpr uint16_t SLOT_SIZE = (CAPACITY + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;        /**< CAPACITY rounded up to whole pages */
+    static constexpr uint32_t FOOTPRINT = 2UL * SLOT_SIZE;                                           /**< Both slots */
+
+    static_assert(CAPACITY >= HEADER_SIZE + Schema::MAX_ENCODED_SIZE, "TLV record capacity too small for the schema");
+    static_assert(FOOTPRINT <= EepromM24C<model>::MEMORY_SIZE, "TLV record slots exceed the memory size");
+
+    using Value = typename Schema::Type;
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param record_address Start address of the two slots, FOOTPRINT bytes. Must be a multiple of PAGE_SIZE.
+     * @param partition_instance Optional partition the record belongs to, must be mounted before Load.
+     */
+    EepromM24CTlvRecord(EepromM24C<model> &eeprom_instance, uint16_t record_address, const EepromM24CPartition<model> *partition_instance = nullptr)
+        : eeprom(eeprom_instance), partition(partition_instance), address(record_address) {}
+
+    TlvLoadResult Load(Value &value);
+    void Store(const Value &value);
+
+    /**
+     * @brief Schema version of the record as found by the last Load.
+     */
+    uint8_t StoredVersion() const { return stored_version; }
+
+    /**
+     * @brief Indicates whether the stored record still uses an older schema version.
+     */
+    bool IsMigrationPending() const { return stored_version != Schema::SCHEMA_VERSION; }
+
+private:
+    static constexpr uint8_t RECORD_MAGIC = 0x5A; /**< Marks a written record, erased memory reads 0xFF */
+    static constexpr uint8_t NONE = 0xFF;
+
+    /**
+     * @brief State of a slot as found by ReadSlot.
+     */
+    enum class SlotState
+    {
+        Empty,   /**< Erased, or written before the last factory reset */
+        Corrupt, /**< Written in this epoch but failed the integrity check, e.g. torn by a power loss */
+        Valid,   /**< Header and fields intact, the slot is in buffer */
+    };
+
+    uint16_t Epoch() const { return partition != nullptr ? partition->Epoch() : 0; }
+    uint16_t SlotAddress(uint8_t slot) const { return address + slot * SLOT_SIZE; }
+
+    SlotState ReadSlot(uint8_t slot, uint8_t &slot_sequence);
+    SlotState Scan();
+
+    EepromM24C<model> &eeprom;
+    const EepromM24CPartition<model> *partition;
+    uint16_t address;
+    uint8_t stored_version = Schema::SCHEMA_VERSION;
+    uint8_t active_slot = NONE;  // Slot of the newest valid record, NONE if there is none
+    uint8_t sequence = 0;        // Sequence of the newest valid record
+    bool scanned = false;        // active_slot and sequence reflect the EEPROM
+    uint8_t buffer[CAPACITY];
+};
+
+// ========================================= TLV Record Implementation ==========================================
+
+/**
+ * @brief Loads and decodes the newest valid slot. Records of other schema versions are converted in RAM only.
+ * @param value The structure to decode into. Fields absent from the stored record keep their value.
+ * @return The load result. Corrupt only if no slot holds a valid record of the current epoch.
+ */
+template <EepromM24CModel model, typename Schema, uint16_t CAPACITY>
+TlvLoadResult EepromM24CTlvRecord<model, Schema, CAPACITY>::Load(Value &value)
+{
+    SlotState state = Scan();
+
+    if (state != SlotState::Valid)
+    {
+        return state == SlotState::Empty ? TlvLoadResult::Empty : TlvLoadResult::Corrupt;
+    }
+
+    uint8_t version = buffer[1];
+    uint16_t length = static_cast<uint16_t>(buffer[4] | (buffer[5] << 8));
+    Value decoded = value;
+
+    if (!Schema::Decode(buffer + HEADER_SIZE, length, decoded))
+    {
+        return TlvLoadResult::Corrupt;
+    }
+
+    value = decoded;
+    stored_version = version;
+
+    return version == Schema::SCHEMA_VERSION ? TlvLoadResult::Current : TlvLoadResult::Migrated;
+}
+
+/**
+ * @brief Encodes the record in the current schema version and writes it to the slot that does not hold
+ * the newest valid record. The new record supersedes the old one only once it is complete.
+ * @param value The structure to store.
+ */
+template <EepromM24CModel model, typename Schema, uint16_t CAPACITY>
+void EepromM24CTlvRecord<model, Schema, CAPACITY>::Store(const Value &value)
+{
+    if (!scanned)
+    {
+        Scan();
+    }
+
+    uint8_t slot = active_slot == 0 ? 1 : 0;
+    uint8_t slot_sequence = active_slot == NONE ? 0 : static_cast<uint8_t>(sequence + 1);
+    uint16_t length = Schema::Encode(value, buffer + HEADER_SIZE);
+
+    buffer[0] = RECORD_MAGIC;
+    buffer[1] = Schema::SCHEMA_VERSION;
+    buffer[2] = static_cast<uint8_t>(Epoch());
+    buffer[3] = static_cast<uint8_t>(Epoch() >> 8);
+    buffer[4] = static_cast<uint8_t>(length);
+    buffer[5] = static_cast<uint8_t>(length >> 8);
+    buffer[6] = slot_sequence;
+
+    uint16_t crc = EepromCrc16(buffer + HEADER_SIZE, length, EepromCrc16(buffer, 7));
+
+    buffer[7] = static_cast<uint8_t>(crc);
+    buffer[8] = static_cast<uint8_t>(crc >> 8);
+
+    eeprom.WriteBlock(buffer, SlotAddress(slot), HEADER_SIZE + length);
+    active_slot = slot;
+    sequence = slot_sequence;
+    stored_version = Schema::SCHEMA_VERSION;
+}
+
+/**
+ * @brief Reads a slot into the buffer and checks it.
+ * @param slot_sequence Receives the sequence of a valid slot.
+ */
+template <EepromM24CModel model, typename Schema, uint16_t CAPACITY>
+typename EepromM24CTlvRecord<model, Schema, CAPACITY>::SlotState EepromM24CTlvRecord<model, Schema, CAPACITY>::ReadSlot(uint8_t slot, uint8_t &slot_sequence)
+{
+    eeprom.ReadBlock(buffer, SlotAddress(slot), HEADER_SIZE);
+
+    if (buffer[0] != RECORD_MAGIC)
+    {
+        return SlotState::Empty;
+    }
+
+    uint16_t epoch = static_cast<uint16_t>(buffer[2] | (buffer[3] << 8));
+    uint16_t length = static_cast<uint16_t>(buffer[4] | (buffer[5] << 8));
+    uint16_t crc = static_cast<uint16_t>(buffer[7] | (buffer[8] << 8));
+
+    if (epoch != Epoch())
+    {
+        return SlotState::Empty; // Written before the last factory reset, the slot is free
+    }
+
+    if (length > CAPACITY - HEADER_SIZE)
+    {
+        return SlotState::Corrupt;
+    }
+
+    if (length > 0)
+    {
+        eeprom.ReadBlock(buffer + HEADER_SIZE, SlotAddress(slot) + HEADER_SIZE, length);
+    }
+
+    if (EepromCrc16(buffer + HEADER_SIZE, length, EepromCrc16(buffer, 7)) != crc)
+    {
+        return SlotState::Corrupt;
+    }
+
+    slot_sequence = buffer[6];
+
+    return SlotState::Valid;
+}
+
+/**
+ * @brief Finds the newest valid slot and leaves it in the buffer.
+ * @return Valid if a slot holds a record, otherwise Corrupt if a slot of the current epoch failed the check, Empty if not.
+ */
+template <EepromM24CModel model, typename Schema, uint16_t CAPACITY>
+typename EepromM24CTlvRecord<model, Schema, CAPACITY>::SlotState EepromM24CTlvRecord<model, Schema, CAPACITY>::Scan()
+{
+    uint8_t sequence_a = 0, sequence_b = 0;
+    SlotState state_a = ReadSlot(0, sequence_a);
+    SlotState state_b = ReadSlot(1, sequence_b);
+
+    scanned = true;
+
+    if (state_a != SlotState::Valid && state_b != SlotState::Valid)
+    {
+        active_slot = NONE;
+        return state_a == SlotState::Corrupt || state_b == SlotState::Corrupt ? SlotState::Corrupt : SlotState::Empty;
+    }
+
+    if (state_b == SlotState::Valid && (state_a != SlotState::Valid || static_cast<int8_t>(sequence_b - sequence_a) > 0))
+    {
+        active_slot = 1; // Still in the buffer
+        sequence = sequence_b;
+        return SlotState::Valid;
+    }
+
+    active_slot = 0;
+    sequence = sequence_a;
+
+    return ReadSlot(0, sequence_a);
+}
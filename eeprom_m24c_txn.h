@@ -0,0 +1,418 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Transactions with group commit
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_m24c.h"
+#include "eeprom_m24c_crc.h"
+
+// ========================================= Eeprom M24C Transactions ==========================================
+
+/**
+ * @brief One write of a transaction.
+ */
+struct EepromM24CTxnWrite
+{
+    uint16_t address; /**< EEPROM address, any alignment */
+    const void *data; /**< Data to write */
+    uint16_t size;    /**< Size of the data */
+};
+
+/**
+ * @brief Atomic multi-write transactions with group commit over a redo journal.
+ *
+ * Commit does not write anything: the transaction is merged into the open batch of page images and a
+ * ticket is returned. Service commits the batch once it has been open for WINDOW_MS, so transactions of
+ * several tasks arriving within the window share page writes and a single commit record. Writes return
+ * while the chip programs, so with a time source (see EepromM24C::IsBusy) the window also stays open until
+ * the write cycle of the previous batch has ended: transactions arriving during the cycle join the next
+ * batch instead of waiting for the chip one by one. A transaction that does not fit the open batch commits
+ * the batch first, one that touches more than BATCH_PAGES pages is rejected.
+ *
+ * A batch commit writes the page images to the journal, then the commit record [magic][sequence LE16]
+ * [page count][home page indices][crc LE16], the CRC covering the record and the images, then the home
+ * pages. Mount replays the last valid batch. Replay compares every home page with its image and only
+ * rewrites differing pages, so it is idempotent and costs no write cycle after a clean shutdown.
+ *
+ * All home addresses must lie outside the journal. The class is not thread-safe, tasks of an RTOS share it
+ * under the application's lock.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam BATCH_PAGES Maximum number of distinct pages in a batch.
+ * @tparam WINDOW_MS How long a batch stays open for more transactions.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS = 10>
+class EepromM24CTransactions
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE;                               /**< Page size in bytes for the specified model */
+    static constexpr uint16_t RECORD_SIZE = 4 + BATCH_PAGES + 2;                                     /**< Commit record size */
+    static constexpr uint16_t RECORD_PAGES = (RECORD_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;             /**< Pages of the commit record */
+    static constexpr uint16_t JOURNAL_SIZE = (RECORD_PAGES + BATCH_PAGES) * PAGE_SIZE;              /**< Journal footprint */
+
+    static_assert(BATCH_PAGES > 0, "A batch needs at least one page");
+    static_assert(EepromM24C<model>::MEMORY_SIZE / PAGE_SIZE <= 0x100, "Home page index is stored in one byte");
+    static_assert(JOURNAL_SIZE <= EepromM24C<model>::MEMORY_SIZE, "Journal exceeds the memory size");
+
+    /**
+     * @param eeprom_instance The EEPROM driver.
+     * @param journal_address Start address of the journal. Must be a multiple of PAGE_SIZE.
+     */
+    EepromM24CTransactions(EepromM24C<model> &eeprom_instance, uint16_t journal_address)
+        : eeprom(eeprom_instance), journal(journal_address) {}
+
+    void Mount();
+
+    uint16_t Commit(const EepromM24CTxnWrite *writes, uint8_t count);
+    void Service(uint32_t now_ms);
+    void Flush();
+
+    void Read(void *data, uint16_t address, uint16_t data_size);
+
+    /**
+     * @brief Checks whether the transaction of the ticket reached the EEPROM.
+     */
+    bool IsDurable(uint16_t ticket) const { return static_cast<int16_t>(durable_sequence - ticket) >= 0; }
+
+    /**
+     * @brief Transactions waiting in the open batch.
+     */
+    uint8_t PendingTransactions() const { return pending_transactions; }
+
+private:
+    static constexpr uint8_t RECORD_MAGIC = 0x7C;
+
+    uint16_t RecordAddress() const { return journal; }
+    uint16_t ImageAddress(uint8_t index) const { return journal + (RECORD_PAGES + index) * PAGE_SIZE; }
+
+    uint8_t FindPage(uint16_t page_address) const;
+    uint8_t PagesMissing(const EepromM24CTxnWrite *writes, uint8_t count, uint8_t known_pages) const;
+    void CommitBatch();
+    void WriteRecord(const uint8_t *record);
+
+    EepromM24C<model> &eeprom;
+    uint16_t journal;
+    uint16_t durable_sequence = 0;    // Last committed batch
+    uint8_t page_count = 0;           // Pages in the open batch
+    uint8_t pending_transactions = 0;
+    bool window_started = false;
+    uint32_t window_start_ms = 0;
+    uint8_t home[BATCH_PAGES];        // Home page index of every image
+    uint8_t images[BATCH_PAGES][PAGE_SIZE];
+};
+
+// ========================================= Eeprom M24C Transactions Implementation ==========================================
+
+/**
+ * @brief Replays the last committed batch. Call it once before any other method.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::Mount()
+{
+    uint8_t record[RECORD_SIZE];
+
+    page_count = 0;
+    pending_transactions = 0;
+    window_started = false;
+
+    eeprom.ReadBlock(record, RecordAddress(), RECORD_SIZE);
+
+    uint8_t count = record[3];
+
+    if (record[0] != RECORD_MAGIC || count == 0 || count > BATCH_PAGES)
+    {
+        return;
+    }
+
+    uint16_t crc = EepromCrc16(record, 4 + count);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        eeprom.ReadBlock(images[i], ImageAddress(i), PAGE_SIZE);
+        crc = EepromCrc16(images[i], PAGE_SIZE, crc);
+    }
+
+    if (crc != static_cast<uint16_t>(record[4 + count] | (record[5 + count] << 8)))
+    {
+        return; // Torn commit: the batch never became durable and the home pages were not touched
+    }
+
+    durable_sequence = static_cast<uint16_t>(record[1] | (record[2] << 8));
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t current[PAGE_SIZE];
+        uint16_t page_address = record[4 + i] * PAGE_SIZE;
+
+        eeprom.ReadBlock(current, page_address, PAGE_SIZE);
+
+        if (memcmp(current, images[i], PAGE_SIZE) != 0)
+        {
+            eeprom.WritePage(images[i], page_address, PAGE_SIZE);
+        }
+    }
+}
+
+/**
+ * @brief Adds a transaction to the open batch. Nothing is written unless the batch is full.
+ * @param writes The writes of the transaction, applied atomically.
+ * @param count Number of writes.
+ * @return Ticket for IsDurable, 0 if the transaction touches more than BATCH_PAGES pages; the open batch
+ * is left alone then.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+uint16_t EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::Commit(const EepromM24CTxnWrite *writes, uint8_t count)
+{
+    if (PagesMissing(writes, count, 0) > BATCH_PAGES)
+    {
+        return 0;
+    }
+
+    if (page_count + PagesMissing(writes, count, page_count) > BATCH_PAGES)
+    {
+        CommitBatch();
+    }
+
+    for (uint8_t w = 0; w < count; w++)
+    {
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(writes[w].data);
+        uint16_t address = writes[w].address;
+        uint16_t data_size = writes[w].size;
+
+        while (data_size > 0)
+        {
+            uint16_t page_address = address - (address % PAGE_SIZE);
+            uint8_t offset = static_cast<uint8_t>(address - page_address);
+            uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+            uint8_t index = FindPage(page_address);
+
+            if (index == page_count)
+            {
+                if (chunk != PAGE_SIZE)
+                {
+                    eeprom.ReadBlock(images[index], page_address, PAGE_SIZE);
+                }
+
+                home[index] = static_cast<uint8_t>(page_address / PAGE_SIZE);
+                page_count++;
+            }
+
+            memcpy(images[index] + offset, data, chunk);
+
+            data += chunk;
+            address += chunk;
+            data_size -= chunk;
+        }
+    }
+
+    pending_transactions++;
+
+    uint16_t ticket = static_cast<uint16_t>(durable_sequence + 1);
+
+    return ticket != 0 ? ticket : 1;
+}
+
+/**
+ * @brief Commits the open batch once its window has elapsed and the chip has finished the previous write
+ * cycle. Call it periodically.
+ * @param now_ms Current time in milliseconds. The window starts at the first call that sees the batch.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::Service(uint32_t now_ms)
+{
+    if (page_count == 0)
+    {
+        return;
+    }
+
+    if (!window_started)
+    {
+        window_started = true;
+        window_start_ms = now_ms;
+    }
+
+    // Committing during the write cycle would only wait for the chip, keep collecting transactions instead
+    if (now_ms - window_start_ms >= WINDOW_MS && !eeprom.IsBusy())
+    {
+        CommitBatch();
+    }
+}
+
+/**
+ * @brief Commits the open batch immediately.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::Flush()
+{
+    if (page_count > 0)
+    {
+        CommitBatch();
+    }
+}
+
+/**
+ * @brief Reads data, pages of the open batch included.
+ * @param data Pointer to the buffer to store the read data.
+ * @param address The EEPROM address to read from. Any alignment.
+ * @param data_size The size of the data.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::Read(void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page_address = address - (address % PAGE_SIZE);
+        uint8_t offset = static_cast<uint8_t>(address - page_address);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+        uint8_t index = FindPage(page_address);
+
+        if (index < page_count)
+        {
+            memcpy(data, images[index] + offset, chunk);
+        }
+        else
+        {
+            eeprom.ReadBlock(data, address, chunk);
+        }
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Index of the page in the open batch, page_count if it is not there.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+uint8_t EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::FindPage(uint16_t page_address) const
+{
+    uint8_t index = 0;
+
+    while (index < page_count && home[index] != page_address / PAGE_SIZE)
+    {
+        index++;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Counts the distinct pages of a transaction that are not among the first pages of the open batch.
+ * @param known_pages Batch pages to count as present: page_count for the open batch, 0 for all pages of the transaction.
+ * @return The count, BATCH_PAGES + 1 if it exceeds BATCH_PAGES.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+uint8_t EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::PagesMissing(const EepromM24CTxnWrite *writes, uint8_t count, uint8_t known_pages) const
+{
+    uint16_t missing_pages[BATCH_PAGES + 1];
+    uint8_t missing = 0;
+
+    for (uint8_t w = 0; w < count; w++)
+    {
+        if (writes[w].size == 0)
+        {
+            continue;
+        }
+
+        uint16_t first = writes[w].address / PAGE_SIZE;
+        uint16_t last = (writes[w].address + writes[w].size - 1) / PAGE_SIZE;
+
+        for (uint16_t page = first; page <= last; page++)
+        {
+            bool known = FindPage(page * PAGE_SIZE) < known_pages;
+
+            for (uint8_t i = 0; i < missing && !known; i++)
+            {
+                known = missing_pages[i] == page;
+            }
+
+            if (!known)
+            {
+                if (missing == BATCH_PAGES)
+                {
+                    return BATCH_PAGES + 1;
+                }
+
+                missing_pages[missing++] = page;
+            }
+        }
+    }
+
+    return missing;
+}
+
+/**
+ * @brief Journals the batch, writes the commit record and applies the pages to their home locations.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::CommitBatch()
+{
+    uint8_t record[RECORD_SIZE];
+    uint16_t sequence = static_cast<uint16_t>(durable_sequence + 1);
+
+    if (page_count == 0)
+    {
+        return;
+    }
+
+    sequence = sequence != 0 ? sequence : 1;
+
+    record[0] = RECORD_MAGIC;
+    record[1] = static_cast<uint8_t>(sequence);
+    record[2] = static_cast<uint8_t>(sequence >> 8);
+    record[3] = page_count;
+    memcpy(record + 4, home, page_count);
+
+    uint16_t crc = EepromCrc16(record, 4 + page_count);
+
+    for (uint8_t i = 0; i < page_count; i++)
+    {
+        eeprom.WritePage(images[i], ImageAddress(i), PAGE_SIZE);
+        crc = EepromCrc16(images[i], PAGE_SIZE, crc);
+    }
+
+    record[4 + page_count] = static_cast<uint8_t>(crc);
+    record[5 + page_count] = static_cast<uint8_t>(crc >> 8);
+
+    WriteRecord(record);
+
+    // The batch is durable from here, a power loss during the home writes is repaired by Mount
+    for (uint8_t i = 0; i < page_count; i++)
+    {
+        eeprom.WritePage(images[i], home[i] * PAGE_SIZE, PAGE_SIZE);
+    }
+
+    durable_sequence = sequence;
+    page_count = 0;
+    pending_transactions = 0;
+    window_started = false;
+}
+
+/**
+ * @brief Writes the used part of the commit record, one WritePage per page.
+ */
+template <EepromM24CModel model, uint8_t BATCH_PAGES, uint16_t WINDOW_MS>
+void EepromM24CTransactions<model, BATCH_PAGES, WINDOW_MS>::WriteRecord(const uint8_t *record)
+{
+    uint16_t record_size = 4 + page_count + 2;
+
+    for (uint16_t offset = 0; offset < record_size; offset += PAGE_SIZE)
+    {
+        uint8_t chunk = static_cast<uint8_t>(record_size - offset < PAGE_SIZE ? record_size - offset : PAGE_SIZE);
+
+        eeprom.WritePage(const_cast<uint8_t *>(record + offset), RecordAddress() + offset, chunk);
+    }
+}
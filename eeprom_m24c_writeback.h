@@ -0,0 +1,315 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Write-back buffer with ordering epochs
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom_m24c.h"
+
+// ========================================= Eeprom M24C Write-back ==========================================
+
+/**
+ * @brief Write-back page buffer with epoch/barrier ordering.
+ *
+ * Writes are merged into page-sized slots in RAM and flushed later as whole pages, one write cycle per page
+ * no matter how many times the page was modified. Writes inside one epoch may be flushed in any order
+ * (the buffer flushes them by ascending address); Barrier() closes the epoch. Every page of an epoch
+ * reaches the EEPROM before any page of a later epoch.
+ *
+ * When a page that is still dirty in an older epoch is written again, the older epochs are flushed first,
+ * so a barrier is never crossed by merging.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ * @tparam SLOTS Number of page slots kept in RAM.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+class EepromM24CWriteBack
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromM24C<model>::PAGE_SIZE; /**< Page size in bytes for the specified model */
+
+    static_assert(SLOTS > 0, "Write-back buffer needs at least one slot");
+
+    EepromM24CWriteBack(EepromM24C<model> &eeprom_instance) : eeprom(eeprom_instance) {}
+
+    void Write(const void *data, uint16_t address, uint16_t data_size);
+    void Read(void *data, uint16_t address, uint16_t data_size);
+
+    void Barrier();
+    bool FlushPage();
+    void Flush();
+
+    /**
+     * @brief Epoch that new writes are assigned to.
+     */
+    uint16_t CurrentEpoch() const { return current_epoch; }
+
+    /**
+     * @brief Number of dirty pages waiting to be flushed.
+     */
+    uint8_t DirtyPages() const;
+
+    /**
+     * @brief The driver the buffer flushes to.
+     */
+    const EepromM24C<model> &Driver() const { return eeprom; }
+
+private:
+    /**
+     * @brief Compares epochs, tolerant to counter wrap-around.
+     */
+    static bool IsEpochBefore(uint16_t a, uint16_t b) { return static_cast<int16_t>(a - b) < 0; }
+
+    struct Slot
+    {
+        bool dirty;
+        uint16_t page_address;
+        uint16_t epoch;
+        uint8_t data[PAGE_SIZE];
+    };
+
+    Slot *FindSlot(uint16_t page_address);
+    Slot *OldestSlot();
+    Slot *AllocateSlot(uint16_t page_address, bool full_page);
+    void FlushThrough(uint16_t epoch);
+
+    EepromM24C<model> &eeprom;
+    uint16_t current_epoch = 0;
+    Slot slots[SLOTS] = {};
+};
+
+// ========================================= Eeprom M24C Write-back Implementation ==========================================
+
+/**
+ * @brief Buffers a write. Nothing reaches the EEPROM until the page is flushed.
+ * @param data Pointer to the data to write.
+ * @param address The EEPROM address to write to. Any alignment.
+ * @param data_size The size of the data.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+void EepromM24CWriteBack<model, SLOTS>::Write(const void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page_address = address - (address % PAGE_SIZE);
+        uint8_t offset = static_cast<uint8_t>(address - page_address);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+
+        Slot *slot = FindSlot(page_address);
+
+        if (slot != nullptr && slot->epoch != current_epoch)
+        {
+            FlushThrough(slot->epoch); // The page belongs to an older epoch, don't merge across the barrier
+            slot = nullptr;
+        }
+
+        if (slot == nullptr)
+        {
+            slot = AllocateSlot(page_address, chunk == PAGE_SIZE);
+        }
+
+        memcpy(slot->data + offset, data, chunk);
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Reads data, dirty pages are served from the buffer.
+ * @param data Pointer to the buffer to store the read data.
+ * @param address The EEPROM address to read from. Any alignment.
+ * @param data_size The size of the data.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+void EepromM24CWriteBack<model, SLOTS>::Read(void *data_ptr, uint16_t address, uint16_t data_size)
+{
+    uint8_t *data = reinterpret_cast<uint8_t *>(data_ptr);
+
+    while (data_size > 0)
+    {
+        uint16_t page_address = address - (address % PAGE_SIZE);
+        uint8_t offset = static_cast<uint8_t>(address - page_address);
+        uint8_t chunk = static_cast<uint8_t>(data_size < PAGE_SIZE - offset ? data_size : PAGE_SIZE - offset);
+
+        Slot *slot = FindSlot(page_address);
+
+        if (slot != nullptr)
+        {
+            memcpy(data, slot->data + offset, chunk);
+        }
+        else
+        {
+            eeprom.ReadBlock(data, address, chunk);
+        }
+
+        data += chunk;
+        address += chunk;
+        data_size -= chunk;
+    }
+}
+
+/**
+ * @brief Closes the current epoch. Writes issued after the barrier are flushed after all writes issued before it.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+void EepromM24CWriteBack<model, SLOTS>::Barrier()
+{
+    for (Slot &slot : slots)
+    {
+        if (slot.dirty && slot.epoch == current_epoch)
+        {
+            current_epoch++; // Empty epochs are not opened, so the counter only moves when it matters
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Flushes a single page: the lowest address of the oldest epoch.
+ * Lets the application spread the flush over idle time, one write cycle per call.
+ * @return true if more dirty pages remain, false otherwise.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+bool EepromM24CWriteBack<model, SLOTS>::FlushPage()
+{
+    Slot *slot = OldestSlot();
+
+    if (slot != nullptr)
+    {
+        eeprom.WritePage(slot->data, slot->page_address, PAGE_SIZE);
+        slot->dirty = false;
+    }
+
+    return DirtyPages() > 0;
+}
+
+/**
+ * @brief Flushes all dirty pages, epoch by epoch.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+void EepromM24CWriteBack<model, SLOTS>::Flush()
+{
+    while (FlushPage())
+    {
+    }
+}
+
+template <EepromM24CModel model, uint8_t SLOTS>
+uint8_t EepromM24CWriteBack<model, SLOTS>::DirtyPages() const
+{
+    uint8_t count = 0;
+
+    for (const Slot &slot : slots)
+    {
+        count += slot.dirty ? 1 : 0;
+    }
+
+    return count;
+}
+
+template <EepromM24CModel model, uint8_t SLOTS>
+typename EepromM24CWriteBack<model, SLOTS>::Slot *EepromM24CWriteBack<model, SLOTS>::FindSlot(uint16_t page_address)
+{
+    for (Slot &slot : slots)
+    {
+        if (slot.dirty && slot.page_address == page_address)
+        {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Finds the next slot to flush: oldest epoch first, ascending address inside the epoch.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+typename EepromM24CWriteBack<model, SLOTS>::Slot *EepromM24CWriteBack<model, SLOTS>::OldestSlot()
+{
+    Slot *oldest = nullptr;
+
+    for (Slot &slot : slots)
+    {
+        if (!slot.dirty)
+        {
+            continue;
+        }
+
+        if (oldest == nullptr || IsEpochBefore(slot.epoch, oldest->epoch) ||
+            (slot.epoch == oldest->epoch && slot.page_address < oldest->page_address))
+        {
+            oldest = &slot;
+        }
+    }
+
+    return oldest;
+}
+
+/**
+ * @brief Takes a free slot for the page, flushing the oldest epoch when the buffer is full.
+ * @param page_address The start address of the page.
+ * @param full_page true if the caller overwrites the whole page, the page is not read back then.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+typename EepromM24CWriteBack<model, SLOTS>::Slot *EepromM24CWriteBack<model, SLOTS>::AllocateSlot(uint16_t page_address, bool full_page)
+{
+    Slot *free_slot = nullptr;
+
+    while (free_slot == nullptr)
+    {
+        for (Slot &slot : slots)
+        {
+            if (!slot.dirty)
+            {
+                free_slot = &slot;
+                break;
+            }
+        }
+
+        if (free_slot == nullptr)
+        {
+            FlushThrough(OldestSlot()->epoch);
+        }
+    }
+
+    if (!full_page)
+    {
+        eeprom.ReadBlock(free_slot->data, page_address, PAGE_SIZE);
+    }
+
+    free_slot->dirty = true;
+    free_slot->page_address = page_address;
+    free_slot->epoch = current_epoch;
+
+    return free_slot;
+}
+
+/**
+ * @brief Flushes every page of the given epoch and of all older epochs.
+ */
+template <EepromM24CModel model, uint8_t SLOTS>
+void EepromM24CWriteBack<model, SLOTS>::FlushThrough(uint16_t epoch)
+{
+    Slot *slot = OldestSlot();
+
+    while (slot != nullptr && !IsEpochBefore(epoch, slot->epoch))
+    {
+        eeprom.WritePage(slot->data, slot->page_address, PAGE_SIZE);
+        slot->dirty = false;
+        slot = OldestSlot();
+    }
+}
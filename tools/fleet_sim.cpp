@@ -0,0 +1,678 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Fleet wear and lifetime simulator
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ *
+ * Runs a workload on many simulated M24C16 devices in parallel and projects their end of life from the
+ * wear of the hottest page. Each device scales the workload periods by its own usage factor, so the fleet
+ * covers light and heavy users.
+ *
+ * Build (host, from the tools directory):
+ *   g++ -std=c++17 -O2 -pthread fleet_sim.cpp -o fleet_sim
+ *
+ * Usage:
+ *   fleet_sim [--devices N] [--days D] [--threads T] [--seed S] [--policy raw|writeback|ftl]
+ *             [--skip-unchanged] [--flush-s SECONDS] [--endurance CYCLES] [--warranty YEARS]
+ *             [--trace FILE]
+ *
+ * Trace format, one write per line, '#' starts a comment:
+ *   <time in seconds> <address> <size> <changed 0|1>
+ * A write with changed = 0 stores the same bytes as the previous write of that address.
+ * Without a trace a synthetic workload is used: a runtime counter, periodic sensor extremes, hourly
+ * settings saves and an event log ring.
+ *
+ * Wear grows linearly with time for a periodic workload, so the simulated period only needs to cover the
+ * workload pattern, the lifetime is extrapolated from it.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "m24c_sim.h"
+#include "../eeprom_m24c_writeback.h"
+#include "../eeprom_m24c_ftl.h"
+
+namespace
+{
+
+constexpr EepromM24CModel MODEL = EepromM24CModel::M24C16;
+constexpr uint8_t FTL_LOGICAL_PAGES = 64;
+constexpr uint8_t WRITEBACK_SLOTS = 8;
+constexpr double SECONDS_PER_YEAR = 365.25 * 24 * 3600;
+
+using Simulator = M24CSimulator<MODEL>;
+using Driver = EepromM24C<MODEL>;
+using Ftl = EepromM24CFtl<MODEL, FTL_LOGICAL_PAGES>;
+
+enum class Policy
+{
+    Raw,
+    WriteBack,
+    Ftl,
+};
+
+struct Options
+{
+    uint32_t devices = 256;
+    double days = 30;
+    uint32_t threads = 0;
+    uint32_t seed = 1;
+    Policy policy = Policy::Raw;
+    bool skip_unchanged = false;
+    double flush_s = 600;
+    double endurance = 1000000;
+    double warranty_years = 10;
+    std::string trace;
+};
+
+/**
+ * @brief One stream of writes: a fixed record rewritten periodically, or a ring advancing on every write.
+ */
+struct Record
+{
+    uint16_t address;
+    uint8_t size;
+    double period_s;
+    double change_probability;
+    uint16_t ring_entries; // > 1 for a ring of consecutive entries
+};
+
+struct TraceWrite
+{
+    double time_s;
+    uint16_t address;
+    uint8_t size;
+    bool changed;
+};
+
+const Record SYNTHETIC_WORKLOAD[] = {
+    {0, 4, 60, 1.0, 1},      // Runtime counter
+    {16, 8, 300, 0.5, 1},    // Sensor extremes
+    {32, 12, 3600, 0.05, 1}, // Settings
+    {64, 8, 900, 1.0, 64},   // Event log ring, 512 bytes
+};
+
+// ========================================= Storage stacks ==========================================
+
+/**
+ * @brief Write path under test. Addresses are logical byte addresses of the workload.
+ */
+class Stack
+{
+public:
+    virtual ~Stack() = default;
+    virtual void Write(uint16_t address, const uint8_t *data, uint8_t size) = 0;
+    virtual void Read(uint16_t address, uint8_t *data, uint8_t size) = 0;
+    virtual void Tick(double now_s) { (void)now_s; }
+    virtual void Finish() {}
+};
+
+class RawStack : public Stack
+{
+public:
+    explicit RawStack(Driver &driver) : eeprom(driver) {}
+
+    void Write(uint16_t address, const uint8_t *data, uint8_t size) override
+    {
+        while (size > 0)
+        {
+            uint8_t chunk = static_cast<uint8_t>(std::min<uint16_t>(size, Driver::PAGE_SIZE - address % Driver::PAGE_SIZE));
+
+            eeprom.WritePage(const_cast<uint8_t *>(data), address, chunk);
+            address += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    void Read(uint16_t address, uint8_t *data, uint8_t size) override { eeprom.ReadBlock(data, address, size); }
+
+private:
+    Driver &eeprom;
+};
+
+class WriteBackStack : public Stack
+{
+public:
+    WriteBackStack(Driver &driver, double flush_period_s) : buffer(driver), flush_period(flush_period_s) {}
+
+    void Write(uint16_t address, const uint8_t *data, uint8_t size) override { buffer.Write(data, address, size); }
+    void Read(uint16_t address, uint8_t *data, uint8_t size) override { buffer.Read(data, address, size); }
+
+    void Tick(double now_s) override
+    {
+        if (now_s >= next_flush)
+        {
+            buffer.Flush();
+            next_flush = now_s + flush_period;
+        }
+    }
+
+    void Finish() override { buffer.Flush(); }
+
+private:
+    EepromM24CWriteBack<MODEL, WRITEBACK_SLOTS> buffer;
+    double flush_period;
+    double next_flush = 0;
+};
+
+class FtlStack : public Stack
+{
+public:
+    explicit FtlStack(Driver &driver) : ftl(driver)
+    {
+        ftl.Mount();
+        memset(image, 0xFF, sizeof(image));
+    }
+
+    void Write(uint16_t address, const uint8_t *data, uint8_t size) override
+    {
+        while (size > 0)
+        {
+            uint8_t logical = static_cast<uint8_t>(address / Ftl::PAYLOAD_SIZE);
+            uint8_t offset = static_cast<uint8_t>(address % Ftl::PAYLOAD_SIZE);
+            uint8_t chunk = static_cast<uint8_t>(std::min<uint16_t>(size, Ftl::PAYLOAD_SIZE - offset));
+
+            memcpy(image[logical] + offset, data, chunk);
+            ftl.Write(logical, image[logical]);
+            address += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    void Read(uint16_t address, uint8_t *data, uint8_t size) override
+    {
+        // The FTL pages are mirrored in RAM, as the application would keep them
+        for (uint8_t i = 0; i < size; i++, address++)
+        {
+            data[i] = image[address / Ftl::PAYLOAD_SIZE][address % Ftl::PAYLOAD_SIZE];
+        }
+    }
+
+private:
+    Ftl ftl;
+    uint8_t image[FTL_LOGICAL_PAGES][Ftl::PAYLOAD_SIZE];
+};
+
+/**
+ * @brief Reads the stored bytes first and drops writes that would not change them.
+ */
+class SkipUnchangedStack : public Stack
+{
+public:
+    explicit SkipUnchangedStack(std::unique_ptr<Stack> inner_stack) : inner(std::move(inner_stack)) {}
+
+    void Write(uint16_t address, const uint8_t *data, uint8_t size) override
+    {
+        uint8_t stored[256];
+
+        inner->Read(address, stored, size);
+
+        if (memcmp(stored, data, size) != 0)
+        {
+            inner->Write(address, data, size);
+        }
+    }
+
+    void Read(uint16_t address, uint8_t *data, uint8_t size) override { inner->Read(address, data, size); }
+    void Tick(double now_s) override { inner->Tick(now_s); }
+    void Finish() override { inner->Finish(); }
+
+private:
+    std::unique_ptr<Stack> inner;
+};
+
+uint16_t AddressSpace(const Options &options)
+{
+    return options.policy == Policy::Ftl ? FTL_LOGICAL_PAGES * Ftl::PAYLOAD_SIZE : Driver::MEMORY_SIZE;
+}
+
+std::unique_ptr<Stack> MakeStack(const Options &options, Driver &driver)
+{
+    std::unique_ptr<Stack> stack;
+
+    switch (options.policy)
+    {
+    case Policy::Raw:
+        stack.reset(new RawStack(driver));
+        break;
+    case Policy::WriteBack:
+        stack.reset(new WriteBackStack(driver, options.flush_s));
+        break;
+    case Policy::Ftl:
+        stack.reset(new FtlStack(driver));
+        break;
+    }
+
+    if (options.skip_unchanged)
+    {
+        stack.reset(new SkipUnchangedStack(std::move(stack)));
+    }
+
+    return stack;
+}
+
+// ========================================= Device simulation ==========================================
+
+struct DeviceResult
+{
+    uint32_t page_cycles[Simulator::PAGES];
+    uint32_t hottest_cycles;
+    double usage_factor;
+    double bus_time_s;
+};
+
+/**
+ * @brief Fills the payload of a write: new random bytes if the data changed, the previous bytes otherwise.
+ */
+void Payload(std::vector<uint8_t> &last, uint16_t address, uint8_t size, bool changed, std::mt19937 &random, uint8_t *out)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        if (changed)
+        {
+            last[address + i] = static_cast<uint8_t>(random());
+        }
+
+        out[i] = last[address + i];
+    }
+}
+
+void SimulateDevice(const Options &options, const std::vector<TraceWrite> &trace, uint32_t device, DeviceResult &result)
+{
+    std::unique_ptr<Simulator> chip(new Simulator());
+    Driver driver(*chip);
+    std::mt19937 random(options.seed * 1000003u + device);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double usage = 0.5 + unit(random); // Light to heavy users, periods scaled by 1 / usage
+    double duration = options.days * 24 * 3600;
+    std::vector<uint8_t> last(AddressSpace(options), 0);
+    uint8_t payload[256];
+
+    // Metadata written while mounting does not belong to the workload
+    std::unique_ptr<Stack> stack = MakeStack(options, driver);
+    memset(chip->page_cycles, 0, sizeof(chip->page_cycles));
+    chip->elapsed_us = 0;
+
+    if (!trace.empty())
+    {
+        double trace_length = trace.back().time_s + 1;
+
+        for (double offset = 0; offset < duration; offset += trace_length / usage)
+        {
+            for (const TraceWrite &write : trace)
+            {
+                double now = offset + write.time_s / usage;
+
+                if (now >= duration)
+                {
+                    break;
+                }
+
+                stack->Tick(now);
+                Payload(last, write.address, write.size, write.changed, random, payload);
+                stack->Write(write.address, payload, write.size);
+            }
+        }
+    }
+    else
+    {
+        const size_t count = sizeof(SYNTHETIC_WORKLOAD) / sizeof(SYNTHETIC_WORKLOAD[0]);
+        double next[count];
+        uint16_t ring_position[count] = {};
+
+        for (size_t i = 0; i < count; i++)
+        {
+            next[i] = unit(random) * SYNTHETIC_WORKLOAD[i].period_s / usage;
+        }
+
+        while (true)
+        {
+            size_t due = static_cast<size_t>(std::min_element(next, next + count) - next);
+            const Record &record = SYNTHETIC_WORKLOAD[due];
+            double now = next[due];
+
+            if (now >= duration)
+            {
+                break;
+            }
+
+            uint16_t address = static_cast<uint16_t>(record.address + ring_position[due] * record.size);
+
+            if (record.ring_entries > 1)
+            {
+                ring_position[due] = static_cast<uint16_t>((ring_position[due] + 1) % record.ring_entries);
+            }
+
+            stack->Tick(now);
+            Payload(last, address, record.size, unit(random) < record.change_probability, random, payload);
+            stack->Write(address, payload, record.size);
+            next[due] += record.period_s / usage;
+        }
+    }
+
+    stack->Finish();
+
+    memcpy(result.page_cycles, chip->page_cycles, sizeof(result.page_cycles));
+    result.hottest_cycles = *std::max_element(chip->page_cycles, chip->page_cycles + Simulator::PAGES);
+    result.usage_factor = usage;
+    result.bus_time_s = chip->elapsed_us / 1e6;
+}
+
+// ========================================= Work-stealing pool ==========================================
+
+/**
+ * @brief Fixed set of independent jobs spread over worker threads.
+ *
+ * Every worker owns a deque seeded round-robin. A worker takes jobs from the back of its own deque and,
+ * once it is empty, steals from the front of the other deques, so uneven job lengths (heavy users simulate
+ * more writes) do not leave cores idle.
+ */
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(uint32_t thread_count) : queues(thread_count) {}
+
+    void Submit(uint32_t job) { queues[submitted++ % queues.size()].jobs.push_back(job); }
+
+    template <typename Function>
+    void Run(Function function)
+    {
+        std::vector<std::thread> workers;
+
+        for (size_t worker = 0; worker < queues.size(); worker++)
+        {
+            workers.emplace_back([this, worker, &function]() {
+                uint32_t job;
+
+                while (Take(worker, job))
+                {
+                    function(job);
+                }
+            });
+        }
+
+        for (std::thread &thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<uint32_t> jobs;
+    };
+
+    bool Take(size_t worker, uint32_t &job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queues[worker].mutex);
+
+            if (!queues[worker].jobs.empty())
+            {
+                job = queues[worker].jobs.back();
+                queues[worker].jobs.pop_back();
+                return true;
+            }
+        }
+
+        // Jobs never spawn jobs, so a full pass without a steal means all work is taken
+        for (size_t i = 1; i < queues.size(); i++)
+        {
+            Queue &victim = queues[(worker + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (!victim.jobs.empty())
+            {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<Queue> queues;
+    size_t submitted = 0;
+};
+
+// ========================================= Input and report ==========================================
+
+bool LoadTrace(const Options &options, std::vector<TraceWrite> &trace)
+{
+    FILE *file = fopen(options.trace.c_str(), "r");
+    char line[256];
+
+    if (file == nullptr)
+    {
+        fprintf(stderr, "cannot open trace %s\n", options.trace.c_str());
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        TraceWrite write;
+        unsigned address, size;
+        int changed;
+
+        if (line[0] == '#' || sscanf(line, "%lf %u %u %d", &write.time_s, &address, &size, &changed) != 4)
+        {
+            continue;
+        }
+
+        if (size == 0 || size > 255 || address + size > AddressSpace(options))
+        {
+            fprintf(stderr, "trace write outside the address space: %s", line);
+            fclose(file);
+            return false;
+        }
+
+        write.address = static_cast<uint16_t>(address);
+        write.size = static_cast<uint8_t>(size);
+        write.changed = changed != 0;
+        trace.push_back(write);
+    }
+
+    fclose(file);
+
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceWrite &a, const TraceWrite &b) { return a.time_s < b.time_s; });
+
+    if (trace.empty())
+    {
+        fprintf(stderr, "trace %s holds no writes\n", options.trace.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (argument == "--skip-unchanged")
+        {
+            options.skip_unchanged = true;
+            continue;
+        }
+
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", argument.c_str());
+            return false;
+        }
+
+        i++;
+
+        if (argument == "--devices")
+            options.devices = static_cast<uint32_t>(atol(value));
+        else if (argument == "--days")
+            options.days = atof(value);
+        else if (argument == "--threads")
+            options.threads = static_cast<uint32_t>(atol(value));
+        else if (argument == "--seed")
+            options.seed = static_cast<uint32_t>(atol(value));
+        else if (argument == "--flush-s")
+            options.flush_s = atof(value);
+        else if (argument == "--endurance")
+            options.endurance = atof(value);
+        else if (argument == "--warranty")
+            options.warranty_years = atof(value);
+        else if (argument == "--trace")
+            options.trace = value;
+        else if (argument == "--policy" && strcmp(value, "raw") == 0)
+            options.policy = Policy::Raw;
+        else if (argument == "--policy" && strcmp(value, "writeback") == 0)
+            options.policy = Policy::WriteBack;
+        else if (argument == "--policy" && strcmp(value, "ftl") == 0)
+            options.policy = Policy::Ftl;
+        else
+        {
+            fprintf(stderr, "unknown option %s %s\n", argument.c_str(), value);
+            return false;
+        }
+    }
+
+    return options.devices > 0 && options.days > 0;
+}
+
+double Percentile(std::vector<double> values, double fraction)
+{
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(fraction * (values.size() - 1))];
+}
+
+void Report(const Options &options, const std::vector<DeviceResult> &results)
+{
+    static const char *POLICY_NAMES[] = {"raw", "writeback", "ftl"};
+    double years = options.days / 365.25;
+    std::vector<double> hottest_per_year;
+    std::vector<double> life_years;
+    std::vector<double> bus_time;
+    double page_mean[Simulator::PAGES] = {};
+    uint32_t early_failures = 0;
+
+    for (const DeviceResult &result : results)
+    {
+        double rate = result.hottest_cycles / years;
+        double life = rate > 0 ? options.endurance / rate : 1e9;
+
+        hottest_per_year.push_back(rate);
+        life_years.push_back(life);
+        bus_time.push_back(result.bus_time_s / options.days);
+        early_failures += life < options.warranty_years ? 1 : 0;
+
+        for (uint16_t page = 0; page < Simulator::PAGES; page++)
+        {
+            page_mean[page] += result.page_cycles[page] / years / results.size();
+        }
+    }
+
+    printf("devices %zu, simulated %.1f days, policy %s%s, workload %s\n", results.size(), options.days,
+           POLICY_NAMES[static_cast<int>(options.policy)], options.skip_unchanged ? "+skip-unchanged" : "",
+           options.trace.empty() ? "synthetic" : options.trace.c_str());
+    printf("hottest page cycles/year: p50 %.0f  p90 %.0f  p99 %.0f  max %.0f\n", Percentile(hottest_per_year, 0.5),
+           Percentile(hottest_per_year, 0.9), Percentile(hottest_per_year, 0.99), Percentile(hottest_per_year, 1.0));
+    printf("projected end of life (years, endurance %.0f): worst %.1f  p1 %.1f  p10 %.1f  p50 %.1f\n", options.endurance,
+           Percentile(life_years, 0.0), Percentile(life_years, 0.01), Percentile(life_years, 0.1), Percentile(life_years, 0.5));
+    printf("devices failing within warranty (%.1f years): %u (%.2f%%)\n", options.warranty_years, early_failures,
+           100.0 * early_failures / results.size());
+    printf("bus time per day: p50 %.2f s  max %.2f s\n", Percentile(bus_time, 0.5), Percentile(bus_time, 1.0));
+
+    std::vector<uint16_t> pages(Simulator::PAGES);
+
+    for (uint16_t page = 0; page < Simulator::PAGES; page++)
+    {
+        pages[page] = page;
+    }
+
+    std::sort(pages.begin(), pages.end(), [&](uint16_t a, uint16_t b) { return page_mean[a] > page_mean[b]; });
+
+    double total = 0;
+    uint16_t worn_pages = 0;
+
+    for (uint16_t page = 0; page < Simulator::PAGES; page++)
+    {
+        total += page_mean[page];
+        worn_pages += page_mean[page] > 0 ? 1 : 0;
+    }
+
+    printf("fleet mean wear: %.0f cycles/year over %u pages (%.0f per worn page)\n", total, worn_pages,
+           worn_pages > 0 ? total / worn_pages : 0.0);
+    printf("hottest pages (mean cycles/year):");
+
+    for (uint16_t i = 0; i < 8 && page_mean[pages[i]] > 0; i++)
+    {
+        printf(" %u:%.0f", pages[i], page_mean[pages[i]]);
+    }
+
+    printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    std::vector<TraceWrite> trace;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: see the header of fleet_sim.cpp\n");
+        return 1;
+    }
+
+    if (!options.trace.empty() && !LoadTrace(options, trace))
+    {
+        return 1;
+    }
+
+    uint32_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<DeviceResult> results(options.devices);
+    std::atomic<uint32_t> finished(0);
+    WorkStealingPool pool(threads);
+
+    for (uint32_t device = 0; device < options.devices; device++)
+    {
+        pool.Submit(device);
+    }
+
+    pool.Run([&](uint32_t device) {
+        SimulateDevice(options, trace, device, results[device]);
+
+        uint32_t done = ++finished;
+
+        if (done % 64 == 0 || done == options.devices)
+        {
+            fprintf(stderr, "\r%u/%u devices", done, options.devices);
+        }
+    });
+
+    fprintf(stderr, "\n");
+    Report(options, results);
+
+    return 0;
+}
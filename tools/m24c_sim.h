@@ -0,0 +1,301 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Simulated device for host tools
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "../eeprom_m24c.h"
+
+// ========================================= M24C Simulator ==========================================
+
+/**
+ * @brief Host-side model of an M24C device behind the I2C_M24C interface.
+ *
+ * Decodes the bus traffic the way the chip does: the device select code carries the upper address bits,
+ * the first byte of a write transaction sets the address counter, further bytes are latched and programmed
+ * at STOP within one page (the address wraps inside the page). Reads continue from the address counter
+ * across the whole memory.
+ *
+ * Every programmed page counts one write cycle for that page. Elapsed time is accumulated from the bus
+ * clock (9 clocks per byte plus START/STOP) and the write cycle time, so tools can compare policies by
+ * bus time as well as by wear.
+ *
+ * With nack_while_busy the write cycle runs in the background like on the chip: a device select during
+ * the write cycle is NACKed and the driver polls, instead of the write cycle being added to the elapsed
+ * time at STOP. forced_nacks NACKs the next device selects regardless, to inject bus faults. After a NACK
+ * the rest of the attempt is ignored until Init(). With time_source the driver gets elapsed_us as its
+ * clock and waits out the write cycle instead of polling; a clock read only takes time when nothing
+ * happened on the bus since the previous one. marginal_hz and fault_rate model a long cable: above that
+ * clock a transaction fails with the given probability, the error shows at its end and the transaction
+ * is lost (a write is not programmed). speed_control lets the driver change bus_hz.
+ *
+ * @tparam model The EEPROM model type from the EepromM24CModel enum.
+ */
+template <EepromM24CModel model>
+class M24CSimulator : public I2C_M24C
+{
+public:
+    static constexpr uint8_t PAGE_SIZE = EepromModelTraits<model>::PAGE_SIZE;
+    static constexpr uint16_t MEMORY_SIZE = EepromModelTraits<model>::MEMORY_SIZE;
+    static constexpr uint16_t PAGES = MEMORY_SIZE / PAGE_SIZE;
+
+    uint8_t memory[MEMORY_SIZE];      /**< Cell contents */
+    uint32_t page_cycles[PAGES] = {}; /**< Write cycles per page */
+    uint64_t write_cycles = 0;        /**< Programmed pages in total */
+    uint64_t transactions = 0;        /**< START conditions */
+    uint64_t bus_bytes = 0;           /**< Bytes transferred, device select codes included */
+    double elapsed_us = 0;            /**< Bus time plus write cycle time */
+    uint32_t bus_hz = 400000;         /**< Bus clock used for the elapsed time */
+    uint32_t write_cycle_us = 5000;   /**< Write cycle time tW */
+    bool nack_while_busy = false;     /**< NACK device selects during the write cycle instead of blocking at STOP */
+    uint32_t forced_nacks = 0;        /**< Device selects still to be NACKed regardless of the write cycle */
+    uint64_t nacks = 0;               /**< NACKed device selects */
+    double busy_until_us = 0;         /**< End of the running write cycle, with nack_while_busy */
+    bool time_source = false;         /**< Offer elapsed_us through GetTimeUs */
+    double clock_read_us = 1;         /**< Time of a GetTimeUs call right after another, so a driver waiting on the clock advances it */
+    bool speed_control = false;       /**< Accept SetBusSpeed */
+    uint32_t marginal_hz = 0;         /**< Above this clock transactions fail with fault_rate, 0 for a clean bus */
+    double fault_rate = 0;            /**< Probability of a bus fault per transaction above marginal_hz */
+    uint32_t seed = 1;                /**< State of the bus fault generator */
+    uint64_t bus_faults = 0;          /**< Transactions failed by a bus fault */
+    double init_us = 0;               /**< Time of an I2C_M24C::Init() */
+
+    M24CSimulator() { memset(memory, 0xFF, sizeof(memory)); }
+
+    void Init() override
+    {
+        error = false;
+        faulted = false;
+        state = State::Idle;
+        elapsed_us += init_us;
+    }
+
+    void StartPolling(uint8_t device_id, I2CMode mode, bool set_pos_bit = false) override
+    {
+        (void)set_pos_bit;
+
+        if (error || Fault())
+        {
+            return;
+        }
+
+        transactions++;
+        AddBusBytes(1);
+        elapsed_us += 2 * 1e6 / bus_hz; // START and STOP
+
+        if (marginal_hz > 0 && bus_hz > marginal_hz && NextRandom() < fault_rate)
+        {
+            bus_faults++;
+            faulted = true;
+        }
+
+        if (mode == TX && (forced_nacks > 0 || (nack_while_busy && elapsed_us < busy_until_us)))
+        {
+            forced_nacks -= forced_nacks > 0 ? 1 : 0;
+            nacks++;
+            error = true;
+            state = State::Idle;
+            return;
+        }
+
+        if (mode == TX)
+        {
+            high_address = static_cast<uint16_t>((device_id & 0x0E) << 7);
+            state = State::Address;
+        }
+        else
+        {
+            state = State::Read;
+        }
+    }
+
+    bool IsStateError() override { return error; }
+
+    bool SetBusSpeed(uint32_t hz) override
+    {
+        if (!speed_control)
+        {
+            return false;
+        }
+
+        bus_hz = hz;
+        return true;
+    }
+
+    bool GetTimeUs(uint32_t &now_us) override
+    {
+        if (!time_source)
+        {
+            return false;
+        }
+
+        if (elapsed_us == last_clock_read_us)
+        {
+            elapsed_us += clock_read_us;
+        }
+
+        last_clock_read_us = elapsed_us;
+        now_us = static_cast<uint32_t>(elapsed_us);
+        return true;
+    }
+
+    uint8_t ReadByte() override
+    {
+        uint8_t value = Next();
+
+        Fault();
+        state = State::Idle;
+        return value;
+    }
+
+    uint16_t ReadHalfWord() override
+    {
+        uint16_t value = Next();
+
+        value |= static_cast<uint16_t>(Next() << 8);
+        Fault();
+        state = State::Idle;
+        return value;
+    }
+
+    void ReadMultipleBytes(uint8_t *output, uint16_t size) override
+    {
+        while (size-- > 0)
+        {
+            *output++ = Next();
+        }
+
+        Fault();
+        state = State::Idle;
+    }
+
+    void WriteByte(uint8_t data) override
+    {
+        if (error)
+        {
+            return;
+        }
+
+        AddBusBytes(1);
+
+        if (state == State::Address)
+        {
+            counter = static_cast<uint16_t>((high_address | data) % MEMORY_SIZE);
+            start_address = counter;
+            latched = 0;
+            state = State::Data;
+        }
+        else if (state == State::Data)
+        {
+            // The page latch wraps: more than PAGE_SIZE bytes overwrite the first ones
+            latch[latched % PAGE_SIZE] = data;
+            latched++;
+        }
+    }
+
+    void Stop() override
+    {
+        if (Fault())
+        {
+            state = State::Idle;
+            return;
+        }
+
+        if (state == State::Data && latched > 0)
+        {
+            uint16_t page_address = start_address - (start_address % PAGE_SIZE);
+            uint16_t count = latched < PAGE_SIZE ? latched : PAGE_SIZE;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                uint16_t offset = static_cast<uint16_t>((start_address + i) % PAGE_SIZE);
+                memory[page_address + offset] = latch[i];
+            }
+
+            page_cycles[page_address / PAGE_SIZE]++;
+            write_cycles++;
+
+            if (nack_while_busy)
+            {
+                busy_until_us = elapsed_us + write_cycle_us;
+            }
+            else
+            {
+                elapsed_us += write_cycle_us;
+            }
+        }
+
+        state = State::Idle;
+    }
+
+private:
+    enum class State
+    {
+        Idle,
+        Address,
+        Data,
+        Read,
+    };
+
+    uint8_t Next()
+    {
+        if (error)
+        {
+            return 0xFF; // Bus released, the line reads high
+        }
+
+        uint8_t value = memory[counter];
+
+        counter = static_cast<uint16_t>((counter + 1) % MEMORY_SIZE);
+        AddBusBytes(1);
+        return value;
+    }
+
+    /**
+     * @brief Ends a transaction hit by a bus fault: the error shows at its end, its data is lost.
+     */
+    bool Fault()
+    {
+        if (!faulted)
+        {
+            return false;
+        }
+
+        faulted = false;
+        error = true;
+        return true;
+    }
+
+    double NextRandom()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed / 4294967296.0;
+    }
+
+    void AddBusBytes(uint32_t count)
+    {
+        bus_bytes += count;
+        elapsed_us += count * 9 * 1e6 / bus_hz;
+    }
+
+    State state = State::Idle;
+    bool error = false;
+    bool faulted = false;
+    uint16_t high_address = 0;
+    uint16_t counter = 0;
+    uint16_t start_address = 0;
+    uint16_t latched = 0;
+    uint8_t latch[PAGE_SIZE];
+    double last_clock_read_us = -1;
+};
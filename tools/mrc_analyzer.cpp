@@ -0,0 +1,281 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Miss-ratio curve analyzer
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ *
+ * Computes page-granular LRU reuse distances of an access trace with the Mattson stack algorithm and
+ * reports, for every cache size from 1 page to the whole device, the miss ratio and the bus time an
+ * EepromM24CPageCache (write-back, LRU) would save against direct driver calls.
+ *
+ * Build (host, from the tools directory):
+ *   g++ -std=c++17 -O2 mrc_analyzer.cpp -o mrc_analyzer
+ *
+ * Usage:
+ *   mrc_analyzer TRACE [--page-size BYTES] [--memory BYTES] [--bus-hz HZ] [--write-cycle-us US]
+ *
+ * Trace format, one driver call per line, '#' starts a comment:
+ *   <R|W> <address> <size>
+ * Addresses and sizes are decimal or 0x-prefixed hex. Defaults describe the M24C16.
+ *
+ * Cost model: every byte on the bus takes 9 clocks. A direct read of n bytes sends the device select,
+ * the address and the select again, then n bytes; a direct write sends select, address and n bytes and
+ * waits one write cycle. With the cache a read hit is free, a miss reads the whole page, a partial write
+ * miss reads the page first. Writes to a page that stayed cached since its previous write are merged,
+ * every other write costs one page write-back.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../eeprom_m24c.h"
+
+namespace
+{
+
+struct Options
+{
+    std::string trace;
+    uint32_t page_size = EepromModelTraits<EepromM24CModel::M24C16>::PAGE_SIZE;
+    uint32_t memory = EepromModelTraits<EepromM24CModel::M24C16>::MEMORY_SIZE;
+    double bus_hz = 400000;
+    double write_cycle_us = 5000;
+};
+
+struct PageAccess
+{
+    uint32_t page;
+    bool write;
+    bool full_page; // The access covers the whole page
+};
+
+/**
+ * @brief Fenwick tree counting the pages whose latest access happened at a given time.
+ */
+class Fenwick
+{
+public:
+    explicit Fenwick(size_t size) : tree(size + 1, 0) {}
+
+    void Add(size_t index, int delta)
+    {
+        for (index++; index < tree.size(); index += index & (~index + 1))
+        {
+            tree[index] += delta;
+        }
+    }
+
+    int64_t Prefix(size_t index) const // Sum over [0, index)
+    {
+        int64_t sum = 0;
+
+        for (; index > 0; index -= index & (~index + 1))
+        {
+            sum += tree[index];
+        }
+
+        return sum;
+    }
+
+private:
+    std::vector<int64_t> tree;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument.compare(0, 2, "--") != 0)
+        {
+            options.trace = argument;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "missing value for %s\n", argument.c_str());
+            return false;
+        }
+
+        const char *value = argv[++i];
+
+        if (argument == "--page-size")
+            options.page_size = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        else if (argument == "--memory")
+            options.memory = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        else if (argument == "--bus-hz")
+            options.bus_hz = atof(value);
+        else if (argument == "--write-cycle-us")
+            options.write_cycle_us = atof(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argument.c_str());
+            return false;
+        }
+    }
+
+    return !options.trace.empty() && options.page_size > 0 && options.memory >= options.page_size;
+}
+
+double ByteTime(const Options &options, double bytes) { return bytes * 9 / options.bus_hz; }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: see the header of mrc_analyzer.cpp\n");
+        return 1;
+    }
+
+    FILE *file = fopen(options.trace.c_str(), "r");
+
+    if (file == nullptr)
+    {
+        fprintf(stderr, "cannot open trace %s\n", options.trace.c_str());
+        return 1;
+    }
+
+    const uint32_t pages = options.memory / options.page_size;
+    std::vector<PageAccess> accesses;
+    double direct_time = 0; // Bus time of the trace without a cache
+    uint64_t calls = 0;
+    char line[256];
+
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        char operation;
+        char address_text[32];
+        char size_text[32];
+
+        if (line[0] == '#' || sscanf(line, " %c %31s %31s", &operation, address_text, size_text) != 3)
+        {
+            continue;
+        }
+
+        bool write = operation == 'W' || operation == 'w';
+        uint32_t address = static_cast<uint32_t>(strtoul(address_text, nullptr, 0));
+        uint32_t size = static_cast<uint32_t>(strtoul(size_text, nullptr, 0));
+
+        if ((!write && operation != 'R' && operation != 'r') || size == 0 || address + size > options.memory)
+        {
+            fprintf(stderr, "skipping invalid trace line: %s", line);
+            continue;
+        }
+
+        calls++;
+        direct_time += write ? ByteTime(options, 2 + size) + options.write_cycle_us / 1e6 * ((address % options.page_size + size + options.page_size - 1) / options.page_size)
+                             : ByteTime(options, 3 + size);
+
+        for (uint32_t page = address / options.page_size; page <= (address + size - 1) / options.page_size; page++)
+        {
+            uint32_t page_start = page * options.page_size;
+            bool full_page = address <= page_start && address + size >= page_start + options.page_size;
+
+            accesses.push_back({page, write, full_page});
+        }
+    }
+
+    fclose(file);
+
+    if (accesses.empty())
+    {
+        fprintf(stderr, "trace %s holds no accesses\n", options.trace.c_str());
+        return 1;
+    }
+
+    // Mattson: the reuse distance of an access is the number of distinct pages touched since the previous
+    // access of the same page, +1. An LRU cache of C pages hits exactly the accesses with distance <= C.
+    const uint32_t INFINITE = 0xFFFFFFFF;
+    std::vector<uint64_t> read_hits_at(pages + 2, 0);        // Reads by distance
+    std::vector<uint64_t> write_hits_at(pages + 2, 0);       // Writes by distance
+    std::vector<uint64_t> partial_write_at(pages + 2, 0);    // Partial writes by distance
+    std::vector<uint64_t> merged_at(pages + 2, 0);           // Writes by worst distance since the previous write
+    std::vector<int64_t> last_time(pages, -1);
+    std::vector<uint32_t> worst_since_write(pages, INFINITE); // INFINITE: no write since the page was last cold
+    Fenwick latest(accesses.size());
+    uint64_t reads = 0, writes = 0, partial_writes = 0;
+
+    for (size_t time = 0; time < accesses.size(); time++)
+    {
+        const PageAccess &access = accesses[time];
+        uint32_t distance = INFINITE;
+
+        if (last_time[access.page] >= 0)
+        {
+            distance = static_cast<uint32_t>(latest.Prefix(time) - latest.Prefix(static_cast<size_t>(last_time[access.page]) + 1) + 1);
+            latest.Add(static_cast<size_t>(last_time[access.page]), -1);
+        }
+
+        latest.Add(time, 1);
+        last_time[access.page] = static_cast<int64_t>(time);
+
+        uint32_t bucket = distance == INFINITE ? pages + 1 : distance;
+        uint32_t worst = worst_since_write[access.page] == INFINITE || distance == INFINITE ? INFINITE : std::max(worst_since_write[access.page], distance);
+
+        if (access.write)
+        {
+            writes++;
+            write_hits_at[bucket]++;
+
+            if (!access.full_page)
+            {
+                partial_writes++;
+                partial_write_at[bucket]++;
+            }
+
+            merged_at[worst == INFINITE ? pages + 1 : worst]++;
+            worst_since_write[access.page] = 0;
+        }
+        else
+        {
+            reads++;
+            read_hits_at[bucket]++;
+            worst_since_write[access.page] = worst;
+        }
+    }
+
+    printf("trace %s: %llu calls, %zu page accesses (%llu reads, %llu writes), %u pages of %u bytes\n", options.trace.c_str(),
+           static_cast<unsigned long long>(calls), accesses.size(), static_cast<unsigned long long>(reads),
+           static_cast<unsigned long long>(writes), pages, options.page_size);
+    printf("direct bus time %.3f s (bus %.0f Hz, tW %.0f us)\n\n", direct_time, options.bus_hz, options.write_cycle_us);
+    printf("%6s %8s %10s %10s %10s %12s %12s %8s\n", "pages", "ram_b", "miss_ratio", "read_miss", "writeback", "cached_s", "saved_s", "saved%");
+
+    uint64_t read_hits = 0, write_hits = 0, partial_hits = 0, merged = 0;
+
+    for (uint32_t size = 1; size <= pages; size++)
+    {
+        read_hits += read_hits_at[size];
+        write_hits += write_hits_at[size];
+        partial_hits += partial_write_at[size];
+        merged += merged_at[size];
+
+        uint64_t misses = (reads - read_hits) + (writes - write_hits);
+        uint64_t read_misses = reads - read_hits;
+        uint64_t fetches = read_misses + (partial_writes - partial_hits);
+        uint64_t write_backs = writes - merged;
+        double cached_time = fetches * ByteTime(options, 3 + options.page_size) +
+                             write_backs * (ByteTime(options, 2 + options.page_size) + options.write_cycle_us / 1e6);
+
+        printf("%6u %8u %10.4f %10llu %10llu %12.3f %12.3f %7.1f%%\n", size, size * options.page_size,
+               static_cast<double>(misses) / accesses.size(), static_cast<unsigned long long>(read_misses),
+               static_cast<unsigned long long>(write_backs), cached_time, direct_time - cached_time,
+               100.0 * (direct_time - cached_time) / direct_time);
+    }
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * ----------------------------------
+ * STM EEPROM series M24C driver - Worst-case timing report
+ *
+ * Author: Norman Dryś
+ * Version: 1.0.0
+ * Last change: 2026-10-19
+ * ----------------------------------
+ *
+ * Prints the worst-case duration of the driver calls from eeprom_m24c_timing.h for a bus speed and retry
+ * policy, then validates every bound on the simulated device: each call is run with the chip still busy
+ * from a previous write for a random part of tW, with random injected NACKs, and once with every device
+ * select NACKed until the driver gives up. Both driver modes are reported: polling, and waiting on a time
+ * source (I2C_M24C::GetTimeUs) for the predicted end of the write cycle. The tool fails if a measured
+ * duration exceeds its bound.
+ *
+ * Build (host, from the tools directory):
+ *   g++ -std=c++17 -O2 timing_report.cpp -o timing_report
+ *
+ * Usage:
+ *   timing_report [--bus-hz HZ] [--attempts N] [--full-failed-attempts] [--runs N] [--seed S]
+ *
+ * Without --attempts the smallest count that outlasts a write cycle is used.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../eeprom_m24c_timing.h"
+#include "m24c_sim.h"
+
+namespace
+{
+
+constexpr EepromM24CModel MODEL = EepromM24CModel::M24C16;
+
+using Driver = EepromM24C<MODEL>;
+using Timing = EepromM24CTiming<MODEL>;
+using Simulator = M24CSimulator<MODEL>;
+
+struct Options
+{
+    uint32_t bus_hz = 400000;
+    uint16_t attempts = 0;
+    bool full_failed_attempts = false;
+    uint32_t runs = 200;
+    uint32_t seed = 1;
+};
+
+struct Operation
+{
+    std::string name;
+    uint64_t bound_ns;
+    uint64_t ready_ns; // 0 for reads
+    std::function<void(Driver &, std::mt19937 &)> call;
+};
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (argument == "--full-failed-attempts")
+        {
+            options.full_failed_attempts = true;
+            continue;
+        }
+
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", argument.c_str());
+            return false;
+        }
+
+        i++;
+
+        if (argument == "--bus-hz")
+            options.bus_hz = static_cast<uint32_t>(atol(value));
+        else if (argument == "--attempts")
+            options.attempts = static_cast<uint16_t>(atol(value));
+        else if (argument == "--runs")
+            options.runs = static_cast<uint32_t>(atol(value));
+        else if (argument == "--seed")
+            options.seed = static_cast<uint32_t>(atol(value));
+        else
+        {
+            fprintf(stderr, "unknown option %s %s\n", argument.c_str(), value);
+            return false;
+        }
+    }
+
+    return options.bus_hz > 0;
+}
+
+uint16_t RandomAddress(std::mt19937 &random, uint16_t size, uint16_t alignment)
+{
+    uint16_t slots = static_cast<uint16_t>((Driver::MEMORY_SIZE - size) / alignment + 1);
+
+    return static_cast<uint16_t>(random() % slots * alignment);
+}
+
+std::vector<Operation> Operations(const EepromM24CTimingConfig &config)
+{
+    static uint8_t buffer[Driver::MEMORY_SIZE];
+    std::vector<Operation> operations;
+
+    operations.push_back({"ReadByte", Timing::ReadNs(config, 1), 0,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.ReadByte(RandomAddress(random, 1, 1)); }});
+    operations.push_back({"ReadHalfWord", Timing::ReadNs(config, 2), 0,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.ReadHalfWord(RandomAddress(random, 2, 2)); }});
+    operations.push_back({"ReadWord", Timing::ReadNs(config, 4), 0,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.ReadWord(RandomAddress(random, 4, 4)); }});
+    operations.push_back({"ReadDoubleWord", Timing::ReadNs(config, 8), 0,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.ReadDoubleWord(RandomAddress(random, 8, 8)); }});
+
+    for (uint16_t size : {uint16_t(16), uint16_t(256), Driver::MEMORY_SIZE})
+    {
+        operations.push_back({"ReadBlock " + std::to_string(size), Timing::ReadNs(config, size), 0,
+                              [size](Driver &eeprom, std::mt19937 &random) { eeprom.ReadBlock(buffer, RandomAddress(random, size, 1), size); }});
+    }
+
+    operations.push_back({"WriteByte", Timing::WritePageNs(config, 1), Timing::WritePageNs(config, 1) + Timing::WRITE_CYCLE_NS,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.WriteByte(RandomAddress(random, 1, 1), 0x5A); }});
+    operations.push_back({"WriteHalfWord", Timing::WritePageNs(config, 2), Timing::WritePageNs(config, 2) + Timing::WRITE_CYCLE_NS,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.WriteHalfWord(RandomAddress(random, 2, 2), 0x5AA5); }});
+
+    for (uint16_t size : {uint16_t(16), uint16_t(64), uint16_t(250)})
+    {
+        operations.push_back({"WriteBlock " + std::to_string(size), Timing::WriteBlockNs(config, size), Timing::WriteBlockReadyNs(config, size),
+                              [size](Driver &eeprom, std::mt19937 &random) {
+                                  eeprom.WriteBlock(buffer, RandomAddress(random, size, Driver::PAGE_SIZE), size);
+                              }});
+    }
+
+    operations.push_back({"WriteBlock<64,8>", Timing::WritePageNs(config, 8), Timing::WritePageNs(config, 8) + Timing::WRITE_CYCLE_NS,
+                          [](Driver &eeprom, std::mt19937 &) { eeprom.WriteBlock<64, 8>(buffer); }});
+    operations.push_back({"ErasePage", Timing::ErasePageNs(config), Timing::ErasePageNs(config) + Timing::WRITE_CYCLE_NS,
+                          [](Driver &eeprom, std::mt19937 &random) { eeprom.ErasePage(RandomAddress(random, Driver::PAGE_SIZE, Driver::PAGE_SIZE)); }});
+    operations.push_back({"ChipErase", Timing::ChipEraseNs(config), Timing::ChipEraseReadyNs(config),
+                          [](Driver &eeprom, std::mt19937 &) { eeprom.ChipErase(); }});
+
+    return operations;
+}
+
+/**
+ * @brief Prints the bounds of one driver mode and checks them on a fresh simulated device.
+ * @return false if a measured duration exceeds its bound.
+ */
+bool Validate(const Options &options, const EepromM24CTimingConfig &config)
+{
+    printf("%s\n%-16s %12s %12s %12s %12s %9s\n", config.time_source ? "time source, lazy write-cycle wait" : "polling",
+           "call", "bound_us", "ready_us", "measured_us", "exhausted_us", "timeouts");
+
+    std::mt19937 random(options.seed);
+    Simulator simulator;
+    Driver eeprom(simulator, config.max_attempts);
+    bool valid = true;
+
+    simulator.bus_hz = options.bus_hz;
+    simulator.write_cycle_us = Driver::WRITE_CYCLE_TIME_US;
+    simulator.nack_while_busy = true;
+    simulator.time_source = config.time_source;
+
+    for (const Operation &operation : Operations(config))
+    {
+        double bound_us = operation.bound_ns / 1000.0;
+        double measured_us = 0;
+        uint32_t timeouts = 0;
+
+        for (uint32_t run = 0; run <= options.runs; run++)
+        {
+            bool exhaust = run == options.runs; // Last run: every device select is NACKed
+
+            simulator.busy_until_us = simulator.elapsed_us + std::uniform_real_distribution<double>(0, simulator.write_cycle_us)(random);
+            simulator.forced_nacks = exhaust ? UINT32_MAX : (random() % 4 == 0 ? random() % config.max_attempts : 0);
+            eeprom.ClearTimeout();
+
+            double start_us = simulator.elapsed_us;
+
+            operation.call(eeprom, random);
+
+            double duration_us = simulator.elapsed_us - start_us;
+
+            if (duration_us > bound_us)
+            {
+                printf("bound exceeded: %s took %.3f us\n", operation.name.c_str(), duration_us);
+                valid = false;
+            }
+
+            if (exhaust)
+            {
+                simulator.forced_nacks = 0;
+                simulator.Init();
+                printf("%-16s %12.1f %12.1f %12.1f %12.1f %9u\n", operation.name.c_str(), bound_us,
+                       operation.ready_ns > 0 ? operation.ready_ns / 1000.0 : bound_us, measured_us, duration_us, timeouts);
+                break;
+            }
+
+            measured_us = duration_us > measured_us ? duration_us : measured_us;
+            timeouts += eeprom.IsTimedOut() ? 1 : 0;
+        }
+    }
+
+    printf("\n");
+    return valid;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: see the header of timing_report.cpp\n");
+        return 1;
+    }
+
+    EepromM24CTimingConfig config = {options.bus_hz, 1, options.full_failed_attempts, false};
+    uint16_t min_attempts = Timing::MinAttempts(config);
+
+    config.max_attempts = options.attempts > 0 ? options.attempts : min_attempts;
+
+    printf("M24C16, bus %u Hz, tW %u us, %u attempts per transaction (%u outlast a write cycle)%s\n\n", options.bus_hz,
+           Driver::WRITE_CYCLE_TIME_US, config.max_attempts, min_attempts,
+           config.full_failed_attempts ? ", failed attempts cost a full transaction" : "");
+
+    if (config.max_attempts < min_attempts)
+    {
+        printf("warning: fewer attempts than a write cycle needs, calls right after a write may time out\n\n");
+    }
+
+    bool valid = true;
+
+    for (bool time_source : {false, true})
+    {
+        config.time_source = time_source;
+        valid = Validate(options, config) && valid;
+    }
+
+    printf("%s\n", valid ? "all bounds hold" : "BOUNDS VIOLATED");
+    return valid ? 0 : 1;
+}